@@ -0,0 +1,294 @@
+#pragma once
+/*
+ * Minimal Arduino core for the native (host) build of the effect engine, see test/native/README.md
+ * Only what the effect engine (FX*.cpp, colors.cpp) and its helpers in util.cpp need;
+ * anything talking to hardware is a no-op.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <time.h>
+#include <functional>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_heap_caps.h"
+#include "esp_idf_version.h"
+
+#undef unix  // predefined by host compilers, used as identifier in Toki.h
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_NOINIT_ATTR
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+class __FlashStringHelper;
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+// pointer tables are read with pgm_read_dword() on the MCU (32 bit pointers), keep them full width on the host
+template<class T> using pgm_dword_t = typename std::conditional<std::is_pointer<T>::value, T, uint32_t>::type;
+template<class T> inline pgm_dword_t<T> pgm_read_dword_host(const T *addr) { return *(const pgm_dword_t<T> *)addr; }
+inline uint32_t pgm_read_dword_host(const void *addr) { return *(const uint32_t *)addr; }
+#define pgm_read_dword(addr) pgm_read_dword_host(addr)
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr)   (*(void * const *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define memcpy_P   memcpy
+#define memcmp_P   memcmp
+#define strlen_P   strlen
+#define strcpy_P   strcpy
+#define strncpy_P  strncpy
+#define strcmp_P   strcmp
+#define strcat_P   strcat
+#define strncat_P  strncat
+#define strncmp_P  strncmp
+#define strcasecmp_P strcasecmp
+#define strncasecmp_P strncasecmp
+#define strstr_P   strstr
+#define strchr_P   strchr
+#define sprintf_P  sprintf
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+#define sscanf_P   sscanf
+
+#ifndef PI
+#define PI         3.1415926535897932384626433832795
+#endif
+#ifndef M_TWOPI
+#define M_TWOPI    6.283185307179586476925286766559
+#endif
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define bitRead(value, bit)  (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)   ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define lowByte(w)  ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+using std::min;
+using std::max;
+// size_t is 64 bit on the host, allow the mixed 32/64 bit comparisons that are same-typed on the MCU
+template<class T, class U, class = typename std::enable_if<!std::is_same<T, U>::value>::type>
+constexpr auto min(T a, U b) -> decltype(a < b ? a : b) { return a < b ? a : b; }
+template<class T, class U, class = typename std::enable_if<!std::is_same<T, U>::value>::type>
+constexpr auto max(T a, U b) -> decltype(a > b ? a : b) { return a > b ? a : b; }
+using std::isnan;
+using std::isinf;
+
+#define RX 3
+#define TX 1
+#define LOW    0
+#define HIGH   1
+#define INPUT  0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) { size_t n = len < size - 1 ? len : size - 1; memcpy(dst, src, n); dst[n] = '\0'; }
+  return len;
+}
+inline size_t strlcat(char *dst, const char *src, size_t size) {
+  size_t dlen = strnlen(dst, size);
+  return dlen + strlcpy(dst + dlen, src, size - dlen);
+}
+
+// time (advanced by host program, see millis_set())
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// printing
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) { size_t n = 0; while (size--) n += write(*buffer++); return n; }
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int n) { return printf("%d", n); }
+    size_t print(unsigned n) { return printf("%u", n); }
+    size_t print(long n) { return printf("%ld", n); }
+    size_t print(unsigned long n) { return printf("%lu", n); }
+    size_t print(double n, int digits = 2) { return printf("%.*f", digits, n); }
+    size_t println() { return write((uint8_t)'\n'); }
+    template<typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+      char buf[256];
+      va_list arg;
+      va_start(arg, format);
+      int len = vsnprintf(buf, sizeof(buf), format, arg);
+      va_end(arg);
+      if (len < 0) return 0;
+      return write((const uint8_t *)buf, std::min((size_t)len, sizeof(buf) - 1));
+    }
+    size_t printf_P(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+      char buf[256];
+      va_list arg;
+      va_start(arg, format);
+      int len = vsnprintf(buf, sizeof(buf), format, arg);
+      va_end(arg);
+      if (len < 0) return 0;
+      return write((const uint8_t *)buf, std::min((size_t)len, sizeof(buf) - 1));
+    }
+    virtual void flush() {}
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    size_t readBytes(char *, size_t) { return 0; }
+    size_t readBytes(uint8_t *, size_t) { return 0; }
+    size_t readBytesUntil(char, char *, size_t) { return 0; }
+    bool find(const char *) { return false; }
+    bool findUntil(const char *, const char *) { return false; }
+    void setTimeout(unsigned long) {}
+};
+
+// writes to stdout
+class HardwareSerial : public Stream {
+  public:
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+    size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+    using Print::write;
+    void begin(unsigned long) {}
+    void end() {}
+    operator bool() const { return true; }
+};
+extern HardwareSerial Serial;
+
+class String {
+  public:
+    String(const char *s = "") : _s(s ? s : "") {}
+    String(const __FlashStringHelper *s) : _s(reinterpret_cast<const char *>(s)) {}
+    String(const std::string &s) : _s(s) {}
+    String(char c) : _s(1, c) {}
+    String(int n) : _s(std::to_string(n)) {}
+    String(unsigned n) : _s(std::to_string(n)) {}
+    String(long n) : _s(std::to_string(n)) {}
+    String(unsigned long n) : _s(std::to_string(n)) {}
+    String(float n, unsigned char digits = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", digits, n); _s = b; }
+    String(double n, unsigned char digits = 2) { char b[32]; snprintf(b, sizeof(b), "%.*f", digits, n); _s = b; }
+    const char *c_str() const { return _s.c_str(); }
+    unsigned length() const { return _s.length(); }
+    bool isEmpty() const { return _s.empty(); }
+    bool reserve(unsigned size) { _s.reserve(size); return true; }
+    char operator[](unsigned i) const { return i < _s.length() ? _s[i] : 0; }
+    char charAt(unsigned i) const { return (*this)[i]; }
+    int indexOf(char c, unsigned from = 0) const { size_t p = _s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+    int indexOf(const char *s, unsigned from = 0) const { size_t p = _s.find(s, from); return p == std::string::npos ? -1 : (int)p; }
+    String substring(unsigned from, unsigned to = UINT32_MAX) const { if (from > _s.length()) return String(); return String(_s.substr(from, to - from)); }
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return atof(_s.c_str()); }
+    bool equals(const String &o) const { return _s == o._s; }
+    bool startsWith(const String &o) const { return _s.rfind(o._s, 0) == 0; }
+    bool endsWith(const String &o) const { return _s.size() >= o._s.size() && _s.compare(_s.size() - o._s.size(), o._s.size(), o._s) == 0; }
+    void toLowerCase() { for (auto &c : _s) c = tolower(c); }
+    void toUpperCase() { for (auto &c : _s) c = toupper(c); }
+    void trim() { _s.erase(0, _s.find_first_not_of(" \t\r\n")); _s.erase(_s.find_last_not_of(" \t\r\n") + 1); }
+    String &operator+=(const String &o) { _s += o._s; return *this; }
+    String &operator+=(const char *o) { _s += o ? o : ""; return *this; }
+    String &operator+=(char c) { _s += c; return *this; }
+    bool concat(const char *o) { _s += o ? o : ""; return true; }
+    bool concat(char c) { _s += c; return true; }
+    bool operator==(const String &o) const { return _s == o._s; }
+    bool operator==(const char *o) const { return _s == (o ? o : ""); }
+    bool operator!=(const String &o) const { return _s != o._s; }
+    friend String operator+(const String &a, const String &b) { return String(a._s + b._s); }
+    friend String operator+(const String &a, const char *b) { return String(a._s + (b ? b : "")); }
+  private:
+    std::string _s;
+};
+class StringSumHelper : public String {
+  public:
+    using String::String;
+};
+
+class Printable {
+  public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+class IPAddress {
+  public:
+    IPAddress() : _addr{0,0,0,0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr{a,b,c,d} {}
+    IPAddress(uint32_t a) { memcpy(_addr, &a, 4); }
+    uint8_t operator[](int i) const { return _addr[i]; }
+    uint8_t &operator[](int i) { return _addr[i]; }
+    operator uint32_t() const { uint32_t a; memcpy(&a, _addr, 4); return a; }
+    bool operator==(const IPAddress &o) const { return memcmp(_addr, o._addr, 4) == 0; }
+    bool operator!=(const IPAddress &o) const { return !(*this == o); }
+    String toString() const { char b[16]; snprintf(b, sizeof(b), "%u.%u.%u.%u", _addr[0], _addr[1], _addr[2], _addr[3]); return String(b); }
+  private:
+    uint8_t _addr[4];
+};
+#define INADDR_NONE IPAddress(0,0,0,0)
+
+// ESP object: heap figures come from the host allocator tracking (see stubs.cpp)
+class EspClass {
+  public:
+    uint32_t getFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint32_t getHeapSize();
+    uint32_t getMinFreeHeap() { return getFreeHeap(); }
+    uint32_t getPsramSize() { return 0; }
+    uint32_t getFreePsram() { return 0; }
+    uint32_t getCpuFreqMHz() { return 240; }
+    uint32_t getFlashChipSize() { return 4*1024*1024; }
+    const char *getChipModel() { return "native"; }
+    uint8_t getChipRevision() { return 0; }
+    uint8_t getChipCores() { return 1; }
+    uint64_t getEfuseMac() { return 0; }
+    uint32_t getCycleCount() { return micros() * 240; }
+    void restart() { exit(0); }
+};
+extern EspClass ESP;
+
+inline void *ps_malloc(size_t size) { return malloc(size); }
+inline void *ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void *ps_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
+inline bool psramFound() { return false; }
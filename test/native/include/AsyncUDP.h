@@ -0,0 +1,5 @@
+#pragma once
+// UDP is not used by the host build, types only
+#include <Arduino.h>
+class AsyncUDPPacket {};
+class AsyncUDP {};
@@ -0,0 +1,96 @@
+#pragma once
+// web server types used in WLED headers, nothing is served in the host build
+#include <Arduino.h>
+#include <FS.h>
+
+#define SPIFFS_EDITOR_AIRCOOOKIE
+#define CONTENT_TYPE_JSON "application/json"
+
+typedef enum {
+  HTTP_GET     = 0b00000001,
+  HTTP_POST    = 0b00000010,
+  HTTP_DELETE  = 0b00000100,
+  HTTP_PUT     = 0b00001000,
+  HTTP_PATCH   = 0b00010000,
+  HTTP_HEAD    = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY     = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServerRequest;
+class AsyncWebServerResponse {
+  public:
+    virtual ~AsyncWebServerResponse() {}
+    void addHeader(const String &, const String &) {}
+  protected:
+    int    _code = 0;
+    String _contentType;
+    size_t _contentLength = 0;
+    size_t _sentLength = 0;
+};
+class AsyncAbstractResponse : public AsyncWebServerResponse {
+  public:
+    virtual bool _sourceValid() const { return false; }
+    virtual size_t _fillBuffer(uint8_t *, size_t) { return 0; }
+};
+class AsyncResponseStream : public AsyncAbstractResponse, public Print {
+  public:
+    size_t write(uint8_t) override { return 1; }
+    using Print::write;
+};
+
+class AsyncWebParameter {
+  public:
+    const String &name() const { return _name; }
+    const String &value() const { return _value; }
+  private:
+    String _name, _value;
+};
+
+class AsyncWebServerRequest {
+  public:
+    void *_tempObject = nullptr;
+    WebRequestMethodComposite method() const { return HTTP_GET; }
+    const String &url() const { return _url; }
+    void addInterestingHeader(const String &) {}
+    bool hasArg(const char *) const { return false; }
+    const String &arg(const String &) const { return _url; }
+    bool hasParam(const String &, bool = false, bool = false) const { return false; }
+    AsyncWebParameter *getParam(const String &, bool = false, bool = false) const { return nullptr; }
+    void send(int, const String & = String(), const String & = String()) {}
+    void send(AsyncWebServerResponse *response) { delete response; }
+    AsyncResponseStream *beginResponseStream(const String &, size_t = 1460) { return new AsyncResponseStream(); }
+  private:
+    String _url;
+};
+
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *) {}
+    virtual void handleUpload(AsyncWebServerRequest *, const String &, size_t, uint8_t *, size_t, bool) {}
+    virtual void handleBody(AsyncWebServerRequest *, uint8_t *, size_t, size_t, size_t) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+struct AsyncWebServerQueueLimits { size_t nMax, queueMax, minHeap, heapUsage; };
+class AsyncWebServer {
+  public:
+    AsyncWebServer(uint16_t, const AsyncWebServerQueueLimits & = {}) {}
+};
+
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+
+class AsyncWebSocketClient {
+  public:
+    uint32_t id() const { return 0; }
+};
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+    AsyncWebSocket(const String &) {}
+    size_t count() const { return 0; }
+};
@@ -0,0 +1,34 @@
+#pragma once
+// file system types only, no file system in the host build
+#include <Arduino.h>
+namespace fs {
+  class File : public Stream {
+    public:
+      size_t write(uint8_t) override { return 0; }
+      using Print::write;
+      using Stream::read;
+      size_t read(uint8_t *, size_t) { return 0; }
+      size_t size() const { return 0; }
+      size_t position() const { return 0; }
+      bool seek(uint32_t) { return false; }
+      const char *name() const { return ""; }
+      bool isDirectory() const { return false; }
+      File openNextFile() { return File(); }
+      void close() {}
+      operator bool() const { return false; }
+  };
+  class FS {
+    public:
+      File open(const char *, const char * = "r") { return File(); }
+      File open(const String &path, const char *mode = "r") { return open(path.c_str(), mode); }
+      bool exists(const char *) { return false; }
+      bool exists(const String &) { return false; }
+      bool remove(const char *) { return false; }
+      bool rename(const char *, const char *) { return false; }
+      size_t totalBytes() { return 0; }
+      size_t usedBytes() { return 0; }
+  };
+}
+using fs::File;
+using fs::FS;
+extern fs::FS LittleFS;
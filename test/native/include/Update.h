@@ -0,0 +1,8 @@
+#pragma once
+// OTA updater, no partitions on the host
+class UpdateClass {
+  public:
+    bool canRollBack() { return false; }
+    bool rollBack() { return false; }
+};
+extern UpdateClass Update;
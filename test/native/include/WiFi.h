@@ -0,0 +1,7 @@
+#pragma once
+// network types used in WLED headers, no network in the host build
+#include <Arduino.h>
+#include <IPAddress.h>
+typedef int WiFiEvent_t;
+typedef int wifi_auth_mode_t;
+typedef enum { WIFI_POWER_19_5dBm = 78 } wifi_power_t;
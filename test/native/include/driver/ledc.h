@@ -0,0 +1,4 @@
+#pragma once
+// LEDC channel counts of classic ESP32
+#define LEDC_CHANNEL_MAX    8
+#define LEDC_SPEED_MODE_MAX 2
@@ -0,0 +1,7 @@
+#pragma once
+#include <stdint.h>
+typedef enum { ADC_UNIT_1 = 1 } adc_unit_t;
+typedef enum { ADC_ATTEN_DB_12 = 3 } adc_atten_t;
+typedef enum { ADC_WIDTH_BIT_12 = 3 } adc_bits_width_t;
+typedef struct { uint32_t coeff_a, coeff_b; const uint32_t *low_curve, *high_curve; } esp_adc_cal_characteristics_t;
+int esp_adc_cal_characterize(adc_unit_t unit, adc_atten_t atten, adc_bits_width_t width, uint32_t vref, esp_adc_cal_characteristics_t *chars);
@@ -0,0 +1,5 @@
+#pragma once
+// host build follows the ESP-IDF V5 code paths
+#define ESP_IDF_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+#define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(5, 3, 0)
+#define ESP_IDF_VERSION_MAJOR 5
@@ -0,0 +1,61 @@
+#pragma once
+// FreeRTOS types and the semaphore/task calls used by the host build
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void (*TaskFunction_t)(void *);
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY 0xFFFFFFFFU
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (ms)
+
+// semaphores are real so effect code can be exercised from several std::thread (see test_parallel_fx)
+// mutex and binary semaphore share one implementation (count limited to 1), recursive mutex is separate
+struct HostSemaphore {
+  std::mutex m;
+  std::condition_variable cv;
+  unsigned count;
+  std::recursive_timed_mutex rm;
+  explicit HostSemaphore(unsigned c) : count(c) {}
+};
+inline SemaphoreHandle_t xSemaphoreCreateMutex()          { return new HostSemaphore(1); }
+inline SemaphoreHandle_t xSemaphoreCreateBinary()         { return new HostSemaphore(0); }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return new HostSemaphore(0); }
+inline void vSemaphoreDelete(SemaphoreHandle_t s)         { delete static_cast<HostSemaphore*>(s); }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+  HostSemaphore *h = static_cast<HostSemaphore*>(s);
+  std::unique_lock<std::mutex> lock(h->m);
+  const auto ready = [h]() { return h->count > 0; };
+  if (ticks == portMAX_DELAY) h->cv.wait(lock, ready);
+  else if (!h->cv.wait_for(lock, std::chrono::milliseconds(ticks), ready)) return pdFALSE;
+  h->count--;
+  return pdTRUE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+  HostSemaphore *h = static_cast<HostSemaphore*>(s);
+  { std::lock_guard<std::mutex> lock(h->m); if (h->count) return pdFALSE; h->count = 1; }
+  h->cv.notify_one();
+  return pdTRUE;
+}
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t ticks) {
+  HostSemaphore *h = static_cast<HostSemaphore*>(s);
+  if (ticks == portMAX_DELAY) { h->rm.lock(); return pdTRUE; }
+  return h->rm.try_lock_for(std::chrono::milliseconds(ticks)) ? pdTRUE : pdFALSE;
+}
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) { static_cast<HostSemaphore*>(s)->rm.unlock(); return pdTRUE; }
+
+// no second core: tasks are not created (parallel FX falls back to drawing all segments in loop())
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *, BaseType_t) { return pdFAIL; }
+inline void vTaskDelete(TaskHandle_t) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline void xTaskNotifyGive(TaskHandle_t) {}
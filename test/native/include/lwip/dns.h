@@ -0,0 +1,6 @@
+#pragma once
+// name resolution is not available in the host build, lookups fail
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+inline err_t dns_gethostbyname(const char *, ip_addr_t *, dns_found_callback, void *) { return ERR_ARG; }
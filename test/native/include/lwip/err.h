@@ -0,0 +1,5 @@
+#pragma once
+typedef signed char err_t;
+#define ERR_OK          0
+#define ERR_INPROGRESS -5
+#define ERR_ARG        -16
@@ -0,0 +1,9 @@
+#pragma once
+#include <stddef.h>
+// SHA1 context, only declared so util.cpp compiles (device fingerprinting is not used on the host)
+typedef struct { unsigned char state[96]; } mbedtls_sha1_context;
+void mbedtls_sha1_init(mbedtls_sha1_context *ctx);
+int  mbedtls_sha1_starts(mbedtls_sha1_context *ctx);
+int  mbedtls_sha1_update(mbedtls_sha1_context *ctx, const unsigned char *input, size_t ilen);
+int  mbedtls_sha1_finish(mbedtls_sha1_context *ctx, unsigned char output[20]);
+void mbedtls_sha1_free(mbedtls_sha1_context *ctx);
@@ -0,0 +1,11 @@
+#pragma once
+#include <stdint.h>
+// reset reasons for bootloop detection (never triggered on the host)
+typedef enum { NO_MEAN = 0, POWERON_RESET = 1, RTCWDT_BROWN_OUT_RESET = 15 } RESET_REASON;
+RESET_REASON rtc_get_reset_reason(int cpu_no);
+uint64_t esp_rtc_get_time_us(void);
+typedef enum {
+  ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT,
+  ESP_RST_TASK_WDT, ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO
+} esp_reset_reason_t;
+esp_reset_reason_t esp_reset_reason(void);
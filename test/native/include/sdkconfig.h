@@ -0,0 +1,7 @@
+#pragma once
+// host build follows classic (dual core) ESP32 code paths
+#define CONFIG_IDF_TARGET_ESP32 1
+#define SOC_CPU_CORES_NUM 2
+// internal DRAM window, host pointers never fall inside
+#define SOC_DRAM_LOW  0x3FFAE000
+#define SOC_DRAM_HIGH 0x40000000
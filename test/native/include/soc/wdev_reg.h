@@ -0,0 +1,6 @@
+#pragma once
+// hardware RNG register, reads a deterministic host PRNG (see stubs.cpp)
+#include <stdint.h>
+uint32_t esp_random();
+#define WDEV_RND_REG 0
+#define REG_READ(reg) esp_random()
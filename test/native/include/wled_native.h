@@ -0,0 +1,8 @@
+#pragma once
+// host build helpers, defined in test/native/src/stubs.cpp
+
+// sets up strip for a width x height strip/matrix driven by a single RGB bus (no hardware) with one segment
+void setupNativeStrip(unsigned width, unsigned height);
+
+// stops millis()/micros() at ms so effects using beat*() (millis() based) render reproducibly, ms < 0 resumes real time
+void setNativeClock(long ms);
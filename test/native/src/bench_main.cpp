@@ -0,0 +1,22 @@
+/*
+ * Host effect benchmark, see test/native/README.md
+ * usage: program [width] [height] [frames] [fx]  (defaults: 32 1 200 255 = all effects)
+ * CSV goes to stdout, same format as /fxbench.csv on the device
+ */
+#include "wled.h"
+#include "wled_native.h"
+
+#ifndef PIO_UNIT_TESTING // unit tests bring their own main()
+
+int main(int argc, char **argv) {
+  unsigned width  = argc > 1 ? atoi(argv[1]) : 32;
+  unsigned height = argc > 2 ? atoi(argv[2]) : 1;
+  unsigned frames = argc > 3 ? atoi(argv[3]) : 200;
+  unsigned fx     = argc > 4 ? atoi(argv[4]) : 255;
+
+  setupNativeStrip(width, height);
+  strip.benchmarkEffects(Serial, width, height, frames, fx);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * Host side of the native build: defines the WLED globals (as wled.cpp does on the MCU) and the few
+ * platform functions the effect engine calls. Anything not reachable from the effect engine is
+ * dropped by the linker (--gc-sections), so only what is actually used needs a definition here.
+ */
+#define WLED_DEFINE_GLOBAL_VARS // only in one source file, like wled.cpp
+#include "wled.h"
+#include "wled_native.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <Update.h>
+
+#ifndef NATIVE_HEAP_SIZE
+  #define NATIVE_HEAP_SIZE (320*1024) // emulated internal DRAM (classic ESP32)
+#endif
+
+HardwareSerial Serial;
+EspClass       ESP;
+UpdateClass    Update;
+
+// time
+static const auto bootTime = std::chrono::steady_clock::now();
+
+static std::atomic<long> fixedMillis(-1); // see setNativeClock()
+
+unsigned long micros() {
+  long fixed = fixedMillis;
+  if (fixed >= 0) return fixed * 1000UL;
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - bootTime).count();
+}
+unsigned long millis() { return micros() / 1000; }
+void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(unsigned int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+void yield() {}
+void setNativeClock(long ms) { fixedMillis = ms < 0 ? -1 : ms; }
+
+// deterministic "hardware" RNG so runs are reproducible
+static thread_local uint32_t rngState = 0x2545F491; // per thread, effects may run on several (test_parallel_fx)
+uint32_t esp_random() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+void randomSeed(unsigned long seed) { rngState = seed ? seed : 0x2545F491; }
+long random(long howbig) { return howbig > 0 ? esp_random() % howbig : 0; }
+long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// heap: every capability allocation is tracked so the benchmark can report the high-water mark
+struct alignas(16) AllocHeader { size_t size; };
+static std::atomic<size_t> heapUsed(0); // effects may allocate from several threads (test_parallel_fx)
+
+static void *trackedAlloc(size_t size) {
+  if (heapUsed.fetch_add(size) + size > NATIVE_HEAP_SIZE) { heapUsed -= size; return nullptr; }
+  AllocHeader *h = (AllocHeader *)malloc(sizeof(AllocHeader) + size);
+  if (!h) { heapUsed -= size; return nullptr; }
+  h->size = size;
+  return h + 1;
+}
+
+void heap_caps_free(void *ptr) {
+  if (!ptr) return;
+  AllocHeader *h = (AllocHeader *)ptr - 1;
+  heapUsed -= h->size;
+  free(h);
+}
+
+void *heap_caps_malloc(size_t size, uint32_t) { return trackedAlloc(size); }
+void *heap_caps_calloc(size_t n, size_t size, uint32_t) {
+  void *ptr = trackedAlloc(n * size);
+  if (ptr) memset(ptr, 0, n * size);
+  return ptr;
+}
+void *heap_caps_realloc(void *ptr, size_t size, uint32_t) {
+  if (!ptr) return trackedAlloc(size);
+  if (size == 0) { heap_caps_free(ptr); return nullptr; }
+  size_t oldSize = ((AllocHeader *)ptr - 1)->size;
+  void *newPtr = trackedAlloc(size);
+  if (!newPtr) return nullptr; // original buffer stays valid, same as on the MCU
+  memcpy(newPtr, ptr, std::min(oldSize, size));
+  heap_caps_free(ptr);
+  return newPtr;
+}
+void *heap_caps_malloc_prefer(size_t size, size_t, ...) { return trackedAlloc(size); }
+void *heap_caps_calloc_prefer(size_t n, size_t size, size_t, ...) { return heap_caps_calloc(n, size, 0); }
+void *heap_caps_realloc_prefer(void *ptr, size_t size, size_t, ...) { return heap_caps_realloc(ptr, size, 0); }
+size_t heap_caps_get_free_size(uint32_t) { return NATIVE_HEAP_SIZE - heapUsed; }
+size_t heap_caps_get_largest_free_block(uint32_t) { return NATIVE_HEAP_SIZE - heapUsed; }
+size_t heap_caps_get_total_size(uint32_t) { return NATIVE_HEAP_SIZE; }
+
+uint32_t EspClass::getFreeHeap()    { return heap_caps_get_free_size(MALLOC_CAP_DEFAULT); }
+uint32_t EspClass::getMaxAllocHeap() { return heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT); }
+uint32_t EspClass::getHeapSize()    { return NATIVE_HEAP_SIZE; }
+
+// no usermods: audio reactive effects fall back to simulateSound()
+bool UsermodManager::getUMData(um_data_t **data, uint8_t) {
+  if (data) *data = nullptr;
+  return false;
+}
+
+// no network: the E1.31 receiver global is constructed but never started
+ESPAsyncE131::ESPAsyncE131(e131_packet_callback_function callback) : _callback(callback) {}
+void handleE131Packet(e131_packet_t *, IPAddress, byte, size_t) {}
+
+// bus_manager.cpp is not part of the host build
+namespace BusManager {
+  std::vector<std::unique_ptr<Bus>> busses;
+  // used by WS2812FX::show(), without ABL and hardware
+  void show() { for (auto &bus : busses) bus->show(); }
+  void setPixels(unsigned pix, const uint32_t *c, size_t count) {
+    for (size_t i = 0; i < count; i++)
+      for (auto &bus : busses) if (bus->containsPixel(pix + i)) bus->setPixelColor(pix + i - bus->getStart(), c[i]);
+  }
+  void setSegmentCCT(int16_t cct, bool allowWBCorrection) {
+    if (cct > 255) cct = 255;
+    if (cct >= 0) { if (allowWBCorrection) cct = 1900 + (cct << 5); }
+    else cct = -1;
+    Bus::setCCT(cct);
+  }
+}
+uint8_t Bus::_gAWM = 255;
+int16_t Bus::_cct = -1;
+
+// RGB output without hardware: makes segments RGB capable (palettes are used) and keeps the last frame
+class BusHost : public Bus {
+  public:
+    BusHost(uint16_t len) : Bus(TYPE_WS2812_RGB, 0, RGBW_MODE_MANUAL_ONLY, len), _data(len) {
+      _hasRgb = true;
+      _hasWhite = _hasCCT = false;
+      _valid = true;
+    }
+    void show() override {}
+    void setPixelColor(unsigned pix, uint32_t c) override { if (pix < _len) _data[pix] = c; }
+    uint32_t getPixelColor(unsigned pix) const override { return pix < _len ? _data[pix] : 0; }
+  private:
+    std::vector<uint32_t> _data;
+};
+
+void setupNativeStrip(unsigned width, unsigned height) {
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // done by deserializeConfig() on the MCU, effects rendering with gamma8() stay black without it
+  // 2D effects refuse to run unless the strip is a matrix large enough for the segment
+  strip.isMatrix = height > 1;
+  Segment::maxWidth  = width;
+  Segment::maxHeight = height;
+  BusManager::busses.clear();
+  BusManager::busses.emplace_back(new BusHost(width * height));
+  strip.resetSegments(); // main segment provides the colors used by the benchmark
+  strip.getMainSegment().colors[0] = DEFAULT_COLOR; // orange, like auto segments of a new install
+  strip.updatePixelBuffer(); // frame buffer for strip.show(), like finalizeInit()
+}
@@ -0,0 +1,63 @@
+/*
+ * WS2812FX::show() dirty tracking with the overlay callback installed (wled.cpp always installs handleOverlayDraw()):
+ * unchanged frames are skipped unless the overlay actually draws, pixels it drew are removed by the next full blend.
+ * pio test -e native -f test_overlay_skip
+ */
+#include <unity.h>
+#include "wled.h"
+#include "wled_native.h"
+
+#define WIDTH  4
+#define HEIGHT 4
+#define SEG_COLOR  0x00FF0000
+#define OVERLAY_COLOR 0x000000FF
+
+static bool overlayOn = false;
+static unsigned overlayCalls = 0;
+static void overlay() {
+  overlayCalls++;
+  if (overlayOn) strip.setPixelColor(0, OVERLAY_COLOR); // like the analog clock overlay
+}
+
+void setUp() {
+  strip.setShowCallback(overlay);
+  overlayOn = false;
+  overlayCalls = 0;
+  Segment &seg = strip.getMainSegment();
+  seg.beginDraw();
+  Segment::draw().segment = &seg;
+  seg.fill(SEG_COLOR); // marks segment dirty
+  strip.show();       // blends segment
+}
+void tearDown() { strip.setShowCallback(nullptr); }
+
+void test_unchanged_frame_skipped_with_callback() {
+  strip.show();
+  TEST_ASSERT_EQUAL(2, overlayCalls); // setUp() and this frame
+  TEST_ASSERT_EQUAL(1, strip.getSkippedSegments());
+  TEST_ASSERT_EQUAL(WIDTH * HEIGHT, strip.getSkippedPixels());
+}
+
+void test_overlay_forces_full_blend() {
+  overlayOn = true;
+  strip.show(); // overlay draws for the first time: segment needs no re-blend
+  TEST_ASSERT_EQUAL(OVERLAY_COLOR, strip.getPixelColor(0));
+  strip.show(); // overlay drew into previous frame
+  TEST_ASSERT_EQUAL(0, strip.getSkippedSegments());
+  TEST_ASSERT_EQUAL(OVERLAY_COLOR, strip.getPixelColor(0));
+  overlayOn = false;
+  strip.show(); // full blend removes overlay pixels
+  TEST_ASSERT_EQUAL(0, strip.getSkippedSegments());
+  TEST_ASSERT_EQUAL(SEG_COLOR, strip.getPixelColor(0));
+  strip.show(); // nothing drawn anymore
+  TEST_ASSERT_EQUAL(1, strip.getSkippedSegments());
+  TEST_ASSERT_EQUAL(SEG_COLOR, strip.getPixelColor(0));
+}
+
+int main() {
+  setupNativeStrip(WIDTH, HEIGHT);
+  UNITY_BEGIN();
+  RUN_TEST(test_unchanged_frame_skipped_with_callback);
+  RUN_TEST(test_overlay_forces_full_blend);
+  return UNITY_END();
+}
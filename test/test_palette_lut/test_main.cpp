@@ -0,0 +1,102 @@
+/*
+ * Expanded palette of longer segments (PaletteLUT): color_from_palette() must return exactly what
+ * ColorFromPalette() returns, and palette heavy effects should get faster.
+ * pio test -e native -f test_palette_lut -v   (-v shows the benchmark output)
+ */
+#include <unity.h>
+#include "wled.h"
+#include "wled_native.h"
+
+void setUp() {}
+void tearDown() {}
+
+// same blend type selection as Segment::color_from_palette()
+static TBlendType blendType(bool moving) {
+  switch (paletteBlend) {
+    case 0: return moving ? LINEARBLEND : LINEARBLEND_NOWRAP;
+    case 1: return LINEARBLEND;
+    case 2: return LINEARBLEND_NOWRAP;
+  }
+  return NOBLEND;
+}
+
+static void checkPalettes(Segment &seg) {
+  static const uint8_t palettes[] = {6, 7, 8, 11, 12, 13, 20, 35, 50, 71}; // FastLED and gradient palettes
+  static const uint8_t brightness[] = {255, 254, 128, 1, 0};
+  char msg[64];
+  seg.refreshLightCapabilities(); // RGB capable, see setupNativeStrip()
+  for (uint8_t pal : palettes) {
+    seg.palette = pal;
+    seg.beginDraw();
+    Segment::draw().segment = &seg;
+    for (paletteBlend = 0; paletteBlend < 4; paletteBlend++) for (bool moving : {false, true}) {
+      for (unsigned i = 0; i < 256; i++) for (uint8_t pbri : brightness) {
+        CRGBW expected = ColorFromPalette(Segment::draw().palette, i, pbri, blendType(moving));
+        expected.w = W(Segment::draw().colors[0]);
+        snprintf(msg, sizeof(msg), "pal %u blend %u moving %d index %u bri %u", pal, paletteBlend, moving, i, pbri);
+        TEST_ASSERT_EQUAL_HEX32_MESSAGE(expected.color32, seg.color_from_palette(i, false, moving, 0, pbri), msg);
+      }
+    }
+  }
+  paletteBlend = 0;
+}
+
+void test_lut_matches_ColorFromPalette() {
+  Segment seg(0, WLED_PALETTE_LUT_MIN_LEN);
+  seg.colors[0] = RGBW32(10, 20, 30, 40); // white channel is taken from the segment color
+  checkPalettes(seg);
+}
+
+void test_short_segment_matches_ColorFromPalette() {
+  Segment seg(0, WLED_PALETTE_LUT_MIN_LEN - 1);
+  checkPalettes(seg);
+}
+
+void test_copied_segment_rebuilds_lut() {
+  Segment seg(0, WLED_PALETTE_LUT_MIN_LEN);
+  seg.palette = 11;
+  seg.beginDraw();
+  Segment copy(seg); // old segment of a transition
+  checkPalettes(copy);
+}
+
+void test_lut_only_for_long_segments() {
+  size_t heap = getFreeHeapSize();
+  Segment shortSeg(0, WLED_PALETTE_LUT_MIN_LEN - 1);
+  TEST_ASSERT_EQUAL((WLED_PALETTE_LUT_MIN_LEN - 1) * sizeof(uint32_t), heap - getFreeHeapSize());
+  heap = getFreeHeapSize();
+  Segment longSeg(0, WLED_PALETTE_LUT_MIN_LEN);
+  TEST_ASSERT_EQUAL(WLED_PALETTE_LUT_MIN_LEN * sizeof(uint32_t) + sizeof(PaletteLUT), heap - getFreeHeapSize());
+}
+
+// palette heavy effects on segments just below and at the LUT threshold (compare nspx column)
+void test_benchmark_palette_effects() {
+  for (uint8_t fx : {FX_MODE_PALETTE, FX_MODE_COLORWAVES, FX_MODE_PRIDE_2015}) {
+    strip.benchmarkEffects(Serial, WLED_PALETTE_LUT_MIN_LEN - 1, 1, 2000, fx); // ColorFromPalette()
+    strip.benchmarkEffects(Serial, WLED_PALETTE_LUT_MIN_LEN, 1, 2000, fx);     // PaletteLUT
+  }
+  // raw palette fetch
+  Segment seg(0, WLED_PALETTE_LUT_MIN_LEN);
+  seg.refreshLightCapabilities();
+  seg.palette = 11;
+  seg.beginDraw();
+  Segment::draw().segment = &seg;
+  uint32_t sum = 0;
+  unsigned long t0 = micros();
+  for (unsigned n = 0; n < 1000000; n++) sum += ColorFromPalette(Segment::draw().palette, n, 255 - (n >> 8), LINEARBLEND);
+  unsigned long t1 = micros();
+  for (unsigned n = 0; n < 1000000; n++) sum += seg.color_from_palette(n & 0xFF, false, true, 0, 255 - (n >> 8));
+  unsigned long t2 = micros();
+  Serial.printf("ColorFromPalette: %lu ns, color_from_palette: %lu ns per call (%u)\n", (t1 - t0) / 1000, (t2 - t1) / 1000, sum & 1);
+}
+
+int main() {
+  setupNativeStrip(WLED_PALETTE_LUT_MIN_LEN * 4, 1);
+  UNITY_BEGIN();
+  RUN_TEST(test_lut_matches_ColorFromPalette);
+  RUN_TEST(test_short_segment_matches_ColorFromPalette);
+  RUN_TEST(test_copied_segment_rebuilds_lut);
+  RUN_TEST(test_lut_only_for_long_segments);
+  RUN_TEST(test_benchmark_palette_effects);
+  return UNITY_END();
+}
@@ -0,0 +1,86 @@
+/*
+ * Parallel effect rendering (WLED_ENABLE_PARALLEL_FX): a fixed set of segments drawn serially and by two
+ * std::thread, each with its own draw context (Segment::setDrawContext()), must produce identical frames.
+ * SEGPRNG state is kept per segment so it must not matter which thread draws a segment.
+ * Effects use palettes, noise, beat*() and SEGPRNG only (hw_random() is not per segment), the host clock is stopped per frame.
+ * pio test -e native_parallel
+ */
+#include <unity.h>
+#include <thread>
+#include <vector>
+#include "wled.h"
+#include "wled_native.h"
+
+#ifndef WLED_ENABLE_PARALLEL_FX
+  #error test_parallel_fx needs WLED_ENABLE_PARALLEL_FX (use env native_parallel)
+#endif
+
+#define WIDTH  16
+#define HEIGHT 16
+#define FRAMES 200
+
+static const uint8_t modes[] = {
+  FX_MODE_COLORWAVES, FX_MODE_PALETTE, FX_MODE_RANDOM_CHASE, FX_MODE_TWINKLEUP, // SEGPRNG: random chase & twinkle up
+  FX_MODE_2DOCTOPUS, FX_MODE_2DDNASPIRAL, FX_MODE_2DCRAZYBEES, FX_MODE_2DNOISE   // SEGPRNG: crazy bees
+};
+#define SEGMENTS (sizeof(modes) / sizeof(modes[0]))
+
+void setUp() {}
+void tearDown() {}
+
+// both sets get the same SEGPRNG seeds (taken from hw_random16() in Segment constructor)
+static void makeSegments(std::vector<Segment> &segs) {
+  randomSeed(7);
+  segs.reserve(SEGMENTS);
+  for (size_t i = 0; i < SEGMENTS; i++) {
+    segs.emplace_back(0, WIDTH, 0, HEIGHT);
+    Segment &seg = segs.back();
+    seg.refreshLightCapabilities();
+    for (unsigned c = 0; c < NUM_COLORS; c++) seg.colors[c] = strip.getMainSegment().colors[c];
+    seg.setMode(modes[i], true);
+  }
+}
+
+// draws every second segment starting at first, with its own draw context like the render task
+static void renderHalf(std::vector<Segment> *segs, size_t first) {
+  FxDrawContext draw = FxDrawContext();
+  Segment::setDrawContext(&draw);
+  for (size_t i = first; i < segs->size(); i += 2) strip.renderSegment((*segs)[i], i);
+  Segment::setDrawContext(nullptr);
+}
+
+// frame buffer of all segments
+static void readFrame(std::vector<Segment> &segs, uint32_t *frame) {
+  for (Segment &seg : segs)
+    for (int y = 0; y < HEIGHT; y++) for (int x = 0; x < WIDTH; x++) *frame++ = seg.getPixelColorXY(x, y);
+}
+
+void test_parallel_frames_match_serial() {
+  static uint32_t serialFrame[SEGMENTS * WIDTH * HEIGHT], parallelFrame[SEGMENTS * WIDTH * HEIGHT], lit[SEGMENTS];
+  std::vector<Segment> serial, parallel;
+  makeSegments(serial);
+  makeSegments(parallel);
+  unsigned differ = 0;
+  for (unsigned f = 0; f < FRAMES; f++) {
+    strip.now = f * FRAMETIME_FIXED;
+    setNativeClock(strip.now); // beat*() use millis()
+    for (size_t i = 0; i < SEGMENTS; i++) strip.renderSegment(serial[i], i);
+    std::thread t0(renderHalf, &parallel, 0), t1(renderHalf, &parallel, 1);
+    t0.join();
+    t1.join();
+    readFrame(serial, serialFrame);
+    readFrame(parallel, parallelFrame);
+    if (memcmp(serialFrame, parallelFrame, sizeof(serialFrame)) != 0 && !differ++) Serial.printf("frame %u differs\n", f);
+    for (size_t i = 0; i < SEGMENTS * WIDTH * HEIGHT; i++) lit[i / (WIDTH * HEIGHT)] |= serialFrame[i];
+  }
+  setNativeClock(-1);
+  TEST_ASSERT_EQUAL(0, differ);
+  for (size_t i = 0; i < SEGMENTS; i++) TEST_ASSERT_TRUE(lit[i] != 0); // no effect is blank
+}
+
+int main() {
+  setupNativeStrip(WIDTH, HEIGHT);
+  UNITY_BEGIN();
+  RUN_TEST(test_parallel_frames_match_serial);
+  return UNITY_END();
+}
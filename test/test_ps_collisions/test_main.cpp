@@ -0,0 +1,143 @@
+/*
+ * 2D particle collisions: pairs tested by ParticleSystem2D::handleCollisions() (uniform grid, via its test hook)
+ * while particle effects run, compared to all pairs in range and to the x-axis binning the grid replaced,
+ * and its scratch memory living in segment data.
+ * pio test -e native -f test_ps_collisions -v   (-v shows the benchmark output)
+ */
+#include <unity.h>
+#include <set>
+#include <utility>
+#include <vector>
+#include "wled.h"
+#include "wled_native.h"
+#include "FXparticleSystem.h"
+
+#define WIDTH  32
+#define HEIGHT 32
+
+void mode_particlepit();
+void mode_particlebox();
+
+void setUp() {}
+void tearDown() {}
+
+struct P { uint32_t idx; int32_t x, y, vx, vy; };
+typedef std::set<std::pair<uint32_t, uint32_t>> PairSet;
+
+static void addIfClose(const P &a, const P &b, uint32_t collDist, PairSet &found) {
+  int32_t dx = (b.x + b.vx) - (a.x + a.vx);
+  int32_t dy = (b.y + b.vy) - (a.y + a.vy);
+  if ((uint32_t)(dx * dx) < collDist * collDist && (uint32_t)(dy * dy) < collDist * collDist)
+    found.insert(std::make_pair(min(a.idx, b.idx), max(a.idx, b.idx)));
+}
+
+// reference: every pair
+static PairSet allPairs(const std::vector<P> &p, uint32_t collDist) {
+  PairSet found;
+  for (uint32_t i = 0; i < p.size(); i++)
+    for (uint32_t j = i + 1; j < p.size(); j++) addIfClose(p[i], p[j], collDist, found);
+  return found;
+}
+
+// previous implementation: x-axis bins of 6 pixels with overlap, bins capped at half the particles (overflow is skipped)
+static uint32_t binPairs(const std::vector<P> &p, int32_t maxX, uint32_t collDist) {
+  const uint32_t n = p.size();
+  int32_t binWidth = 6 * PS_P_RADIUS;
+  const int32_t overlap = collDist;
+  const uint32_t maxBinParticles = max((uint32_t)50, (n + 1) / 2);
+  uint32_t numBins = (maxX + (binWidth - 1)) / binWidth;
+  if (n < maxBinParticles) { numBins = 1; binWidth = maxX + 1; }
+  uint32_t tested = 0;
+  for (uint32_t b = 0; b < numBins; b++) {
+    int32_t binStart = b * binWidth - overlap;
+    int32_t binEnd = binStart + binWidth + (overlap << 1);
+    uint32_t binSize = 0;
+    for (uint32_t i = 0; i < n && binSize < maxBinParticles; i++)
+      if (p[i].x >= binStart && p[i].x <= binEnd) binSize++;
+    tested += binSize * (binSize - 1) / 2;
+  }
+  return tested;
+}
+
+// collected by the hooks of ParticleSystem2D::handleCollisions() (one call may run several times per frame)
+static struct {
+  std::vector<P> input;  // colliding particles at start of current call
+  uint32_t collDist;
+  int32_t  maxX;
+  PairSet  tested;       // pairs tested by current call
+  uint32_t calls, gridTested, binTested, inRange, collided, missed;
+} stats;
+
+static void finishCall() {
+  if (stats.input.empty()) return;
+  PairSet reference = allPairs(stats.input, stats.collDist);
+  for (const auto &pair : reference) stats.missed += stats.tested.count(pair) == 0;
+  stats.inRange   += reference.size();
+  stats.binTested += binPairs(stats.input, stats.maxX, stats.collDist);
+  stats.input.clear();
+  stats.tested.clear();
+}
+
+static void hookBegin(const ParticleSystem2D &ps, uint32_t collDist) {
+  finishCall();
+  stats.calls++;
+  stats.collDist = collDist;
+  stats.maxX = ps.maxX;
+  for (uint32_t i = 0; i < ps.usedParticles; i++) {
+    const PSparticle &q = ps.particles[i];
+    if (q.ttl > 0 && !ps.particleFlags[i].outofbounds && ps.particleFlags[i].collide) stats.input.push_back({i, q.x, q.y, q.vx, q.vy});
+  }
+}
+
+static void hookPair(uint32_t i, uint32_t j, bool collided) {
+  stats.gridTested++;
+  stats.collided += collided;
+  stats.tested.insert(std::make_pair(min(i, j), max(i, j)));
+}
+
+// runs a particle effect and checks every call of handleCollisions(): the grid must test all pairs in range and fewer pairs than binning
+static void checkEffect(const char *name, uint8_t mode, void (*fn)(), uint8_t intensity) {
+  stats = {};
+  psCollisionTestHook = {hookBegin, hookPair};
+  Segment seg(0, WIDTH, 0, HEIGHT);
+  seg.refreshLightCapabilities();
+  seg.setMode(mode, true); // default controls
+  seg.intensity = intensity;
+  for (unsigned f = 0; f < 300; f++) {
+    strip.now = f * FRAMETIME_FIXED;
+    seg.beginDraw();
+    Segment::draw().segment = &seg;
+    fn();
+    seg.call++;
+  }
+  finishCall();
+  psCollisionTestHook = {nullptr, nullptr};
+  Serial.printf("%s: %u calls, binning tested %u pairs, grid tested %u, %u pairs in range, %u collided, %u missed\n",
+    name, stats.calls, stats.binTested, stats.gridTested, stats.inRange, stats.collided, stats.missed);
+  TEST_ASSERT_TRUE(stats.calls > 0);
+  TEST_ASSERT_TRUE(stats.collided > 0);
+  TEST_ASSERT_EQUAL(0, stats.missed);            // no pair in range is missed
+  TEST_ASSERT_TRUE(stats.gridTested < stats.binTested);
+}
+
+void test_grid_pairs_ballpit() { checkEffect("Ballpit", FX_MODE_PARTICLEPIT, mode_particlepit, 255); }
+void test_grid_pairs_box()     { checkEffect("Box", FX_MODE_PARTICLEBOX, mode_particlebox, 255); }
+
+// the grid is part of the effect data: nothing is left allocated once the segment is gone
+void test_grid_memory_in_segment_data() {
+  size_t heap = getFreeHeapSize();
+  size_t data = Segment::getUsedSegmentData();
+  for (uint8_t fx : {FX_MODE_PARTICLEPIT, FX_MODE_PARTICLEBOX, FX_MODE_PARTICLEGALAXY})
+    strip.benchmarkEffects(Serial, WIDTH, HEIGHT, 100, fx);
+  TEST_ASSERT_EQUAL(heap, getFreeHeapSize());
+  TEST_ASSERT_EQUAL(data, Segment::getUsedSegmentData());
+}
+
+int main() {
+  setupNativeStrip(WIDTH, HEIGHT);
+  UNITY_BEGIN();
+  RUN_TEST(test_grid_pairs_ballpit);
+  RUN_TEST(test_grid_pairs_box);
+  RUN_TEST(test_grid_memory_in_segment_data);
+  return UNITY_END();
+}
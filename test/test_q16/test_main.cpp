@@ -0,0 +1,127 @@
+/*
+ * Q16.16 fixed point (fixed_point.h) in Julia and Rotozoomer: rendered frames are compared to the float
+ * implementation the effects used before. Julia only differs where the escape iteration is chaotic,
+ * Rotozoomer where rounding picks the neighbouring source pixel.
+ * pio test -e native -f test_q16 -v   (-v shows the measured differences)
+ */
+#include <unity.h>
+#include "wled.h"
+#include "wled_native.h"
+#include "fixed_point.h"
+
+#define WIDTH  32
+#define HEIGHT 32
+#define PALETTE_SOLID_WRAP (paletteBlend == 1 || paletteBlend == 3) // as in FX.cpp
+
+void mode_2DJulia();
+void mode_2Dplasmarotozoom();
+
+void setUp() {}
+void tearDown() {}
+
+static void initSegment(Segment &seg, uint8_t mode) {
+  seg.refreshLightCapabilities();
+  for (unsigned c = 0; c < NUM_COLORS; c++) seg.colors[c] = strip.getMainSegment().colors[c]; // as the benchmark does
+  seg.setMode(mode, true); // default controls
+}
+
+static void drawFrame(Segment &seg, void (*mode)(), unsigned long now) {
+  strip.now = now;
+  seg.beginDraw();
+  Segment::draw().segment = &seg;
+  mode();
+  seg.call++;
+}
+
+void test_q16_helpers() {
+  for (float f : {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 1.99f, -1.99f, 31.7f, -31.7f, 12345.25f, -12345.25f})
+    TEST_ASSERT_EQUAL_INT((int)f, q16_to_int(q16_from_float(f))); // truncates like a float to int cast
+  TEST_ASSERT_EQUAL_INT32(q16_from_float(-3.0f), q16_mul(q16_from_float(1.5f), q16_from_float(-2.0f)));
+  q16_t a = q16_from_float(0.5f), b = q16_from_float(-0.25f);
+  TEST_ASSERT_EQUAL_INT32(q16_from_float(0.3125f), q16_csquare(a, b)); // |z|^2 of the input
+  TEST_ASSERT_EQUAL_INT32(q16_from_float(0.1875f), a);                 // a^2 - b^2
+  TEST_ASSERT_EQUAL_INT32(q16_from_float(-0.25f), b);                  // 2ab
+}
+
+// previous float iteration of mode_2DJulia() with its default controls (center 0,0, area size 1, no blur)
+static uint32_t juliaFloat(Segment &seg, int i, int j, unsigned long now) {
+  const float xmin = -1.0f, xmax = 1.0f, ymin = -0.8f, ymax = 1.0f;
+  const float dx = (xmax - xmin) / WIDTH, dy = (ymax - ymin) / HEIGHT;
+  const int maxIterations = seg.intensity / 2;
+  const float reAl = -0.94299f + (float)sin16_t(now * 34) / 655340.f;
+  const float imAg =  0.3162f  + (float)sin16_t(now * 26) / 655340.f;
+  float x = xmin, y = ymin;
+  for (int n = 0; n < i; n++) x += dx; // same accumulation as the effect
+  for (int n = 0; n < j; n++) y += dy;
+  float a = x, b = y;
+  int iter = 0;
+  while (iter < maxIterations) {
+    float aa = a * a;
+    float bb = b * b;
+    if (aa + bb > 16.0f) break;
+    b = 2*a*b + imAg;
+    a = aa - bb + reAl;
+    iter++;
+  }
+  return iter == maxIterations ? 0 : seg.color_from_palette(iter*255/maxIterations, false, PALETTE_SOLID_WRAP, 0);
+}
+
+// intensity sets the iteration count (intensity/2), more iterations are more sensitive to rounding
+static void checkJulia(uint8_t intensity) {
+  Segment seg(0, WIDTH, 0, HEIGHT);
+  initSegment(seg, FX_MODE_2DJULIA);
+  seg.palette = 11; // rainbow: every iteration count has its own color
+  drawFrame(seg, mode_2DJulia, 0); // first frame resets the controls
+  seg.intensity = intensity;
+  unsigned differ = 0, escaped = 0, total = 0;
+  for (unsigned long now = 397; now < 20000; now += 397) { // c moves along its sin16_t() path
+    drawFrame(seg, mode_2DJulia, now);
+    for (int j = 0; j < HEIGHT; j++) for (int i = 0; i < WIDTH; i++, total++) {
+      uint32_t expected = juliaFloat(seg, i, j, now);
+      differ  += seg.getPixelColorXY(i, j) != expected;
+      escaped += expected != 0;
+    }
+  }
+  Serial.printf("Julia (%u iterations): %u of %u pixels differ from float (%.3f%%), %u escaped\n", intensity / 2, differ, total, 100.0f * differ / total, escaped);
+  TEST_ASSERT_TRUE(escaped > total / 2); // most pixels escape: frames are not blank
+  TEST_ASSERT_TRUE(differ * 10 < total); // < 10%
+}
+
+void test_julia_matches_float()              { checkJulia(24); }
+void test_julia_max_iterations_match_float() { checkJulia(255); }
+
+void test_rotozoomer_matches_float() {
+  Segment seg(0, WIDTH, 0, HEIGHT);
+  initSegment(seg, FX_MODE_2DPLASMAROTOZOOM);
+  unsigned differ = 0, total = 0;
+  for (unsigned f = 0; f < 300; f++) {
+    float angle = seg.data ? *reinterpret_cast<float*>(seg.data) : 0.0f; // angle used by this frame
+    drawFrame(seg, mode_2Dplasmarotozoom, f * FRAMETIME_FIXED);
+    const byte *plasma = seg.data + sizeof(float); // data layout of mode_2Dplasmarotozoom()
+    // previous float rotation
+    float scale   = (sin_t(angle/2)+((128-seg.intensity)/128.0f)+1.1f)/1.5f;
+    float kosinus = cos_t(angle) * scale;
+    float sinus   = sin_t(angle) * scale;
+    for (int j = 0; j < HEIGHT; j++) {
+      float u1 = j * sinus;
+      float v1 = j * kosinus;
+      for (int i = 0; i < WIDTH; i++, total++) {
+        byte u = abs8(i * kosinus - u1) % WIDTH;
+        byte v = abs8(i * sinus + v1) % HEIGHT;
+        differ += seg.getPixelColorXY(i, j) != seg.color_from_palette(plasma[v*WIDTH+u], false, PALETTE_SOLID_WRAP, 255);
+      }
+    }
+  }
+  Serial.printf("Rotozoomer: %u of %u pixels sample another source pixel than float (%.3f%%)\n", differ, total, 100.0f * differ / total);
+  TEST_ASSERT_TRUE(differ * 100 < total); // < 1%
+}
+
+int main() {
+  setupNativeStrip(WIDTH, HEIGHT);
+  UNITY_BEGIN();
+  RUN_TEST(test_q16_helpers);
+  RUN_TEST(test_julia_matches_float);
+  RUN_TEST(test_julia_max_iterations_match_float);
+  RUN_TEST(test_rotozoomer_matches_float);
+  return UNITY_END();
+}
@@ -16,9 +16,22 @@
 #include "fcn_declare.h"
 #include "colors.h"
 #include "prng.h"
+#include "fixed_point.h"
 
 #define FX_FALLBACK_STATIC { mode_static(); return; }
 
+#ifndef WLED_DISABLE_2D
+// row buffer of full-frame 2D effects lives on the stack, wider rows are written in chunks
+#define FX_ROW_CHUNK 64
+
+// stores pixel x of row y in row[] and writes the buffered pixels once the chunk or the row (cols) is complete
+static inline void setRowPixel(uint32_t *row, int x, int y, int cols, uint32_t color) {
+  const unsigned k = x % FX_ROW_CHUNK;
+  row[k] = color;
+  if (k == FX_ROW_CHUNK-1 || x == cols-1) SEGMENT.setPixelRowXY(x - k, y, row, k + 1);
+}
+#endif
+
 #if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
   #include "FXparticleSystem.h" // include particle system code only if at least one system is enabled
   #ifdef WLED_DISABLE_PARTICLESYSTEM2D
@@ -84,8 +97,6 @@
 //#define MAX_FREQUENCY   5120
 //#define MAX_FREQ_LOG10  3.71f
 
-static PRNG prng(hw_random()); // pseudo-random number generator class, seed = hardware random number
-
 // effect utility functions
 static uint8_t sin_gap(uint16_t in) {
   if (in & 0x100) return 0;
@@ -1814,30 +1825,30 @@ static const char _data_FX_MODE_MULTI_COMET[] PROGMEM = "Multi Comet@!,Fade;!,!;
  */
 void mode_random_chase(void) {
   if (SEGENV.call == 0) {
-    SEGENV.step = RGBW32(prng.random8(), prng.random8(), prng.random8(), 0);
-    SEGENV.aux0 = prng.random16();
+    SEGENV.step = RGBW32(SEGPRNG.random8(), SEGPRNG.random8(), SEGPRNG.random8(), 0);
+    SEGENV.aux0 = SEGPRNG.random16();
   }
-  unsigned prevSeed = prng.getSeed(); // save seed so we can restore it at the end of the function
+  unsigned prevSeed = SEGPRNG.getSeed(); // save seed so we can restore it at the end of the function
   uint32_t cycleTime = 25 + (3 * (uint32_t)(255 - SEGMENT.speed));
   uint32_t it = strip.now / cycleTime;
   uint32_t color = SEGENV.step;
-  prng.setSeed(SEGENV.aux0);
+  SEGPRNG.setSeed(SEGENV.aux0);
 
   for (int i = SEGLEN -1; i >= 0; i--) {
-    uint8_t r = prng.random8(6) != 0 ? (color >> 16 & 0xFF) : prng.random8();
-    uint8_t g = prng.random8(6) != 0 ? (color >> 8  & 0xFF) : prng.random8();
-    uint8_t b = prng.random8(6) != 0 ? (color       & 0xFF) : prng.random8();
+    uint8_t r = SEGPRNG.random8(6) != 0 ? (color >> 16 & 0xFF) : SEGPRNG.random8();
+    uint8_t g = SEGPRNG.random8(6) != 0 ? (color >> 8  & 0xFF) : SEGPRNG.random8();
+    uint8_t b = SEGPRNG.random8(6) != 0 ? (color       & 0xFF) : SEGPRNG.random8();
     color = RGBW32(r, g, b, 0);
     SEGMENT.setPixelColor(i, color);
     if (i == SEGLEN -1U && SEGENV.aux1 != (it & 0xFFFFU)) { //new first color in next frame
       SEGENV.step = color;
-      SEGENV.aux0 = prng.getSeed();
+      SEGENV.aux0 = SEGPRNG.getSeed();
     }
   }
 
   SEGENV.aux1 = it & 0xFFFF;
 
-  prng.setSeed(prevSeed); // restore original seed so other effects can use "random" PRNG
+  SEGPRNG.setSeed(prevSeed); // restore original seed so other effects can use "random" PRNG
 }
 static const char _data_FX_MODE_RANDOM_CHASE[] PROGMEM = "Stream 2@!;;";
 
@@ -4342,17 +4353,17 @@ static const char _data_FX_MODE_PHASEDNOISE[] PROGMEM = "Phased Noise@!,!;!,!;!"
 
 
 void mode_twinkleup(void) {                     // A very short twinkle routine with fade-in and dual controls. By Andrew Tuline.
-  unsigned prevSeed = prng.getSeed();           // save seed so we can restore it at the end of the function
-  prng.setSeed(535);                            // The randomizer needs to be re-set each time through the loop in order for the same 'random' numbers to be the same each time through.
+  unsigned prevSeed = SEGPRNG.getSeed();           // save seed so we can restore it at the end of the function
+  SEGPRNG.setSeed(535);                            // The randomizer needs to be re-set each time through the loop in order for the same 'random' numbers to be the same each time through.
 
   for (unsigned i = 0; i < SEGLEN; i++) {
-    unsigned ranstart = prng.random8();         // The starting value (aka brightness) for each pixel. Must be consistent each time through the loop for this to work.
+    unsigned ranstart = SEGPRNG.random8();         // The starting value (aka brightness) for each pixel. Must be consistent each time through the loop for this to work.
     unsigned pixBri = sin8_t(ranstart + 16 * strip.now/(256-SEGMENT.speed));
-    if (prng.random8() > SEGMENT.intensity) pixBri = 0;
-    SEGMENT.setPixelColor(i, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(prng.random8()+strip.now/100, false, PALETTE_SOLID_WRAP, 0), pixBri));
+    if (SEGPRNG.random8() > SEGMENT.intensity) pixBri = 0;
+    SEGMENT.setPixelColor(i, color_blend(SEGCOLOR(1), SEGMENT.color_from_palette(SEGPRNG.random8()+strip.now/100, false, PALETTE_SOLID_WRAP, 0), pixBri));
   }
 
-  prng.setSeed(prevSeed);                       // restore original seed so other effects can use "random" PRNG
+  SEGPRNG.setSeed(prevSeed);                       // restore original seed so other effects can use "random" PRNG
 }
 static const char _data_FX_MODE_TWINKLEUP[] PROGMEM = "Twinkleup@!,Intensity;!,!;!;;m12=0";
 
@@ -4637,10 +4648,10 @@ static const char _data_FX_MODE_WASHING_MACHINE[] PROGMEM = "Washing Machine@!,!
 
 /*
   Image effect
-  Draws a .gif image from filesystem on the matrix/strip
+  Draws a .gif image or plays a .fseq sequence from filesystem on the matrix/strip
 */
 void mode_image(void) {
-  #ifndef WLED_ENABLE_GIF
+  #if !defined(WLED_ENABLE_GIF) && !defined(WLED_ENABLE_FSEQ)
   FX_FALLBACK_STATIC;
   #else
   renderImageToSegment(SEGMENT);
@@ -5383,19 +5394,26 @@ static const char _data_FX_MODE_2DFRIZZLES[] PROGMEM = "Frizzles@X frequency,Y f
 ///////////////////////////////////////////
 //   2D Cellular Automata Game of life   //
 ///////////////////////////////////////////
-typedef struct Cell {
-    uint8_t alive : 1, faded : 1, toggleStatus : 1, edgeCell: 1, oscillatorCheck : 1, spaceshipCheck : 1, unused : 2;
-} Cell;
+// state header, followed by two bit planes (current and next generation), one bit per cell, each row padded to 32 bit words
+typedef struct GameOfLife {
+  uint32_t oscillatorHash; // hash of generation snapshot for oscillator detection (every 16 generations)
+  uint32_t spaceshipHash;  // hash of generation snapshot for glider detection (every gliderLength generations)
+  uint32_t current;        // plane holding the current generation (0 or 1)
+} GameOfLife;
 
 void mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://natureofcode.com/book/chapter-7-cellular-automata/ 
                                    // and https://github.com/DougHaber/nlife-color , Modified By: Brandon Butler
   if (!strip.isMatrix || !SEGMENT.is2D()) FX_FALLBACK_STATIC; // not a 2D set-up
   const int cols = SEG_W, rows = SEG_H;
-  const unsigned maxIndex = cols * rows;
+  const unsigned wpr = (cols + 31) >> 5;                  // words per row
+  const unsigned planeWords = wpr * rows;
+  const unsigned lastBit = (cols - 1) & 31;               // bit of last cell in the last word of a row
+  const uint32_t lastMask = 0xFFFFFFFFU >> (31 - lastBit); // valid cells in the last word of a row (unused bits are kept 0)
 
-  if (!SEGENV.allocateData(SEGMENT.length() * sizeof(Cell))) FX_FALLBACK_STATIC; // allocation failed
+  if (!SEGENV.allocateData(sizeof(GameOfLife) + 2 * planeWords * sizeof(uint32_t))) FX_FALLBACK_STATIC; // allocation failed
 
-  Cell *cells = reinterpret_cast<Cell*> (SEGENV.data);
+  GameOfLife *gol = reinterpret_cast<GameOfLife*>(SEGENV.data);
+  uint32_t *planes = reinterpret_cast<uint32_t*>(SEGENV.data + sizeof(GameOfLife));
 
   uint16_t& generation = SEGENV.aux0, &gliderLength = SEGENV.aux1; // rename aux variables for clarity
   bool mutate = SEGMENT.check3;
@@ -5421,112 +5439,107 @@ void mode_2Dgameoflife(void) { // Written by Ewoud Wijma, inspired by https://na
     generation = 1;
     paused = true;
     //Setup Grid
-    memset(cells, 0, maxIndex * sizeof(Cell));
+    memset(SEGENV.data, 0, sizeof(GameOfLife) + 2 * planeWords * sizeof(uint32_t));
 
-    for (unsigned i = 0; i < maxIndex; i++) {
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
       bool isAlive = !hw_random8(3); // ~33%
-      cells[i].alive = isAlive;
-      cells[i].faded = !isAlive;
-      unsigned x = i % cols, y = i / cols;
-      cells[i].edgeCell = (x == 0 || x == cols-1 || y == 0 || y == rows-1);
-
-      SEGMENT.setPixelColor(i, isAlive ? SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 0) : bgColor);
+      if (isAlive) planes[y * wpr + (x >> 5)] |= 1U << (x & 31);
+      SEGMENT.setPixelColorXY(x, y, isAlive ? SEGMENT.color_from_palette(hw_random8(), false, PALETTE_SOLID_WRAP, 0) : bgColor);
     }
   }
 
+  uint32_t *cur = planes + gol->current * planeWords;
+  uint32_t *nxt = planes + (gol->current ^ 1) * planeWords;
+  auto isAlive = [&](const uint32_t *plane, int x, int y) -> bool { return (plane[y * wpr + (x >> 5)] >> (x & 31)) & 1; };
+
+  // fade dead cells towards background color, returns color to set
+  auto fadeCell = [&](uint32_t cellColor, uint8_t amount) -> uint32_t {
+    uint32_t blended = color_blend(cellColor, bgColor, amount);
+    return blended == cellColor ? bgColor : blended;
+  };
+
   if (paused || (strip.now - SEGENV.step < 1000 / map(SEGMENT.speed,0,255,1,42))) {
     // Redraw if paused or between updates to remove blur
-    for (unsigned i = maxIndex; i--; ) {
-      if (!cells[i].alive) {
-        uint32_t cellColor = SEGMENT.getPixelColor(i);
-        if (cellColor != bgColor) {
-          uint32_t newColor;
-          bool needsColor = false;
-          if (cells[i].faded) { newColor = bgColor; needsColor = true; }
-          else {
-            uint32_t blended = color_blend(cellColor, bgColor, 2);
-            if (blended == cellColor) { blended = bgColor; cells[i].faded = 1; }
-            newColor = blended; needsColor = true;
-          }
-          if (needsColor) SEGMENT.setPixelColor(i, newColor);
-        }
-      }
+    for (int y = 0; y < rows; y++) for (int x = 0; x < cols; x++) {
+      if (isAlive(cur, x, y)) continue;
+      uint32_t cellColor = SEGMENT.getPixelColorXY(x, y);
+      if (cellColor != bgColor) SEGMENT.setPixelColorXY(x, y, fadeCell(cellColor, 2));
     }
     return;
   }
 
-  // Repeat detection
+  // Repeat detection (hash of current generation is compared to snapshots taken every 16 / gliderLength generations)
   bool updateOscillator = generation % 16 == 0;
   bool updateSpaceship  = gliderLength && generation % gliderLength == 0;
-  bool repeatingOscillator = true, repeatingSpaceship = true, emptyGrid = true;
-
-  unsigned cIndex = maxIndex-1;
-  for (unsigned y = rows; y--; ) for (unsigned x = cols; x--; cIndex--) {
-    Cell& cell = cells[cIndex];
-
-    if (cell.alive) emptyGrid = false;
-    if (cell.oscillatorCheck != cell.alive) repeatingOscillator = false;
-    if (cell.spaceshipCheck  != cell.alive) repeatingSpaceship  = false;
-    if (updateOscillator) cell.oscillatorCheck = cell.alive;
-    if (updateSpaceship)  cell.spaceshipCheck  = cell.alive;
-
-    unsigned neighbors = 0, aliveParents = 0, parentIdx[3];
-    // Count alive neighbors
-    for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) if (i || j) {
-      int nX = x + j, nY = y + i;
-      if (cell.edgeCell) {
-        nX = (nX + cols) % cols;
-        nY = (nY + rows) % rows;
-      }
-      unsigned nIndex = nX + nY * cols;
-      Cell& neighbor = cells[nIndex];
-      if (neighbor.alive) {
-        neighbors++;
-        if (!neighbor.toggleStatus && neighbors < 4) { // Alive and not dying
-          parentIdx[aliveParents++] = nIndex;
-        }
-      }
-    }
-
-    uint32_t newColor;
-    bool needsColor = false;
-
-    if (cell.alive && (neighbors < 2 || neighbors > 3)) { // Loneliness or Overpopulation
-      cell.toggleStatus = 1;
-      if (blur == 255) cell.faded = 1;
-      newColor = cell.faded ? bgColor : color_blend(SEGMENT.getPixelColor(cIndex), bgColor, blur);
-      needsColor = true;
-    }
-    else if (!cell.alive) {
-      byte mutationRoll = mutate ? hw_random8(128) : 1; // if 0: 3 neighbor births fail and 2 neighbor births mutate
-      if ((neighbors == 3 && mutationRoll) || (mutate && neighbors == 2 && !mutationRoll)) { // Reproduction or Mutation
-        cell.toggleStatus = 1;
-        cell.faded = 0;
+  uint32_t hash = planeWords; // non-zero seed (hashInt(0) is 0)
+  bool emptyGrid = true;
+  for (unsigned i = 0; i < planeWords; i++) {
+    hash = hashInt(hash ^ cur[i]); // multiply-xorshift mixing per word: every cell affects all bits of the hash
+    if (cur[i]) emptyGrid = false;
+  }
+  bool repeatingOscillator = hash == gol->oscillatorHash;
+  bool repeatingSpaceship  = hash == gol->spaceshipHash;
+  if (updateOscillator) gol->oscillatorHash = hash;
+  if (updateSpaceship)  gol->spaceshipHash  = hash;
+
+  // neighbour rows shifted by one cell (toroidal wrap): bit x of west() is cell x-1, bit x of east() is cell x+1
+  auto west = [&](const uint32_t *r, unsigned k) -> uint32_t {
+    return (r[k] << 1) | (k ? r[k-1] >> 31 : (r[wpr-1] >> lastBit) & 1);
+  };
+  auto east = [&](const uint32_t *r, unsigned k) -> uint32_t {
+    return (r[k] >> 1) | (k + 1 < wpr ? r[k+1] << 31 : (r[0] & 1) << lastBit);
+  };
 
+  // next generation, 32 cells at a time: neighbours are summed with a bit-sliced 3 bit adder (a count of 8 wraps to 0, both mean "no birth, dies")
+  for (int y = 0; y < rows; y++) {
+    const uint32_t *up  = cur + ((y + rows - 1) % rows) * wpr;
+    const uint32_t *mid = cur + y * wpr;
+    const uint32_t *dn  = cur + ((y + 1) % rows) * wpr;
+    for (unsigned k = 0; k < wpr; k++) {
+      uint32_t s0 = 0, s1 = 0, s2 = 0;
+      auto add = [&](uint32_t v) { uint32_t c0 = s0 & v; s0 ^= v; uint32_t c1 = s1 & c0; s1 ^= c0; s2 ^= c1; };
+      add(west(up, k));  add(up[k]); add(east(up, k));
+      add(west(mid, k));             add(east(mid, k));
+      add(west(dn, k));  add(dn[k]); add(east(dn, k));
+      uint32_t two   = ~s0 &  s1 & ~s2;
+      uint32_t three =  s0 &  s1 & ~s2;
+      uint32_t born  = three & ~mid[k];
+      if (mutate) { // 1/128 chance per birth candidate: 3 neighbour births fail and 2 neighbour births mutate
+        for (uint32_t cand = (two | three) & ~mid[k]; cand; cand &= cand - 1)
+          if (!hw_random8(128)) born ^= cand & (~cand + 1);
+      }
+      uint32_t word = born | (mid[k] & (two | three)); // Reproduction or survival, Loneliness or Overpopulation otherwise
+      if (k == wpr - 1) word &= lastMask;
+      nxt[y * wpr + k] = word;
+    }
+  }
+
+  // colour only cells that changed (or still fade)
+  for (int y = 0; y < rows; y++) for (unsigned k = 0; k < wpr; k++) {
+    const uint32_t o = cur[y * wpr + k], n = nxt[y * wpr + k];
+    const uint32_t valid = k == wpr - 1 ? lastMask : 0xFFFFFFFFU;
+    for (uint32_t bits = ~(o & n) & valid; bits; bits &= bits - 1) { // all but surviving cells
+      const int x = (k << 5) + __builtin_ctz(bits);
+      uint32_t cellColor = SEGMENT.getPixelColorXY(x, y);
+      if (n & (bits & (~bits + 1))) { // newborn: take colour of a random surviving neighbour
+        unsigned parentX[8], parentY[8], aliveParents = 0;
+        for (int i = -1; i <= 1; i++) for (int j = -1; j <= 1; j++) if (i || j) {
+          int nX = (x + j + cols) % cols, nY = (y + i + rows) % rows;
+          if (isAlive(cur, nX, nY) && isAlive(nxt, nX, nY)) { parentX[aliveParents] = nX; parentY[aliveParents++] = nY; }
+        }
         if (aliveParents) {
-          // Set color based on random neighbor
-          unsigned parentIndex = parentIdx[hw_random8(aliveParents)];
-          birthColor = SEGMENT.getPixelColor(parentIndex);
+          unsigned p = hw_random8(aliveParents);
+          birthColor = SEGMENT.getPixelColorXY(parentX[p], parentY[p]);
         }
-        newColor = birthColor;
-        needsColor = true;
-      }
-      else if (!cell.faded) {// No change, fade dead cells
-          uint32_t cellColor = SEGMENT.getPixelColor(cIndex);
-          uint32_t blended = color_blend(cellColor, bgColor, blur);
-          if (blended == cellColor) { blended = bgColor; cell.faded = 1; }
-          newColor = blended;
-          needsColor = true;
+        SEGMENT.setPixelColorXY(x, y, birthColor);
+      } else if (o & (bits & (~bits + 1))) { // dying
+        SEGMENT.setPixelColorXY(x, y, blur == 255 ? bgColor : color_blend(cellColor, bgColor, blur));
+      } else if (cellColor != bgColor) { // No change, fade dead cells
+        SEGMENT.setPixelColorXY(x, y, fadeCell(cellColor, blur));
       }
     }
-
-    if (needsColor) SEGMENT.setPixelColor(cIndex, newColor);
-  }
-  // Loop through cells, if toggle, swap alive status
-  for (unsigned i = maxIndex; i--; ) {
-    cells[i].alive ^= cells[i].toggleStatus;
-    cells[i].toggleStatus = 0;
   }
+  gol->current ^= 1;
 
   if (repeatingOscillator || repeatingSpaceship || emptyGrid) {
     generation = 0; // reset on next call
@@ -5581,6 +5594,7 @@ void mode_2DJulia(void) {                           // An animated Julia set by
 
   if (!SEGENV.allocateData(sizeof(julia))) FX_FALLBACK_STATIC;
   Julia* julias = reinterpret_cast<Julia*>(SEGENV.data);
+  uint32_t row[FX_ROW_CHUNK]; // pixels of current row, written at once
 
   float reAl;
   float imAg;
@@ -5632,42 +5646,42 @@ void mode_2DJulia(void) {                           // An animated Julia set by
   dx = (xmax - xmin) / (cols);     // Scale the delta x and y values to our matrix size.
   dy = (ymax - ymin) / (rows);
 
+  // iterate in Q16.16 fixed point: several times faster than float on MCUs without FPU
+  const q16_t re   = q16_from_float(reAl);
+  const q16_t im   = q16_from_float(imAg);
+  const q16_t qMax = q16_from_float(maxCalc);
+  const q16_t qdx  = q16_from_float(dx);
+  const q16_t qdy  = q16_from_float(dy);
+
   // Start y
-  float y = ymin;
+  q16_t y = q16_from_float(ymin);
   for (int j = 0; j < rows; j++) {
 
     // Start x
-    float x = xmin;
+    q16_t x = q16_from_float(xmin);
     for (int i = 0; i < cols; i++) {
 
       // Now we test, as we iterate z = z^2 + c does z tend towards infinity?
-      float a = x;
-      float b = y;
+      q16_t a = x;
+      q16_t b = y;
       int iter = 0;
 
-      while (iter < maxIterations) {    // Here we determine whether or not we're out of bounds.
-        float aa = a * a;
-        float bb = b * b;
-        float len = aa + bb;
-        if (len > maxCalc) {            // |z| = sqrt(a^2+b^2) OR z^2 = a^2+b^2 to save on having to perform a square root.
-          break;  // Bail
-        }
-
-       // This operation corresponds to z -> z^2+c where z=a+ib c=(x,y). Remember to use 'foil'.
-        b = 2*a*b + imAg;
-        a = aa - bb + reAl;
+      // |z| = sqrt(a^2+b^2) OR z^2 = a^2+b^2 to save on having to perform a square root.
+      while (iter < maxIterations && q16_csquare(a, b) <= qMax) { // z -> z^2+c where z=a+ib c=(x,y)
+        a += re;
+        b += im;
         iter++;
-      } // while
+      }
 
       // We color each pixel based on how long it takes to get to infinity, or black if it never gets there.
       if (iter == maxIterations) {
-        SEGMENT.setPixelColorXY(i, j, 0);
+        setRowPixel(row, i, j, cols, 0);
       } else {
-        SEGMENT.setPixelColorXY(i, j, SEGMENT.color_from_palette(iter*255/maxIterations, false, PALETTE_SOLID_WRAP, 0));
+        setRowPixel(row, i, j, cols, SEGMENT.color_from_palette(iter*255/maxIterations, false, PALETTE_SOLID_WRAP, 0));
       }
-      x += dx;
+      x += qdx;
     }
-    y += dy;
+    y += qdy;
   }
   if(SEGMENT.check1)
     SEGMENT.blur(100, true);
@@ -5780,6 +5794,8 @@ void mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have one
   const int cols = SEG_W;
   const int rows = SEG_H;
 
+  uint32_t row[FX_ROW_CHUNK]; // pixels of current row, written at once
+
   float speed = 0.25f * (1+(SEGMENT.speed>>6));
 
   // get some 2 random moving points
@@ -5814,16 +5830,16 @@ void mode_2Dmetaballs(void) {   // Metaballs by Stefan Petrick. Cannot have one
 
       // map color between thresholds
       if (color > 0 and color < 60) {
-        SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(map(color * 9, 9, 531, 0, 255), false, PALETTE_SOLID_WRAP, 0));
+        setRowPixel(row, x, y, cols, SEGMENT.color_from_palette(map(color * 9, 9, 531, 0, 255), false, PALETTE_SOLID_WRAP, 0));
       } else {
-        SEGMENT.setPixelColorXY(x, y, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
+        setRowPixel(row, x, y, cols, SEGMENT.color_from_palette(0, false, PALETTE_SOLID_WRAP, 0));
       }
-      // show the 3 points, too
-      SEGMENT.setPixelColorXY(x1, y1, WHITE);
-      SEGMENT.setPixelColorXY(x2, y2, WHITE);
-      SEGMENT.setPixelColorXY(x3, y3, WHITE);
     }
   }
+  // show the 3 points, too
+  SEGMENT.setPixelColorXY(x1, y1, WHITE);
+  SEGMENT.setPixelColorXY(x2, y2, WHITE);
+  SEGMENT.setPixelColorXY(x3, y3, WHITE);
 } // mode_2Dmetaballs()
 static const char _data_FX_MODE_2DMETABALLS[] PROGMEM = "Metaballs@!;;!;2";
 
@@ -6136,10 +6152,10 @@ void mode_2Dcrazybees(void) {
     uint8_t posX, posY, aimX, aimY, hue;
     int8_t deltaX, deltaY, signX, signY, error;
     void aimed(uint16_t w, uint16_t h) {
-      //prng.setSeed(millis());
-      aimX   = prng.random8(0, w);
-      aimY   = prng.random8(0, h);
-      hue    = prng.random8();
+      //SEGPRNG.setSeed(millis());
+      aimX   = SEGPRNG.random8(0, w);
+      aimY   = SEGPRNG.random8(0, h);
+      hue    = SEGPRNG.random8();
       deltaX = abs(aimX - posX);
       deltaY = abs(aimY - posY);
       signX  = posX < aimX ? 1 : -1;
@@ -6152,10 +6168,10 @@ void mode_2Dcrazybees(void) {
   bee_t *bee = reinterpret_cast<bee_t*>(SEGENV.data);
 
   if (SEGENV.call == 0) {
-    prng.setSeed(strip.now);
+    SEGPRNG.setSeed(strip.now);
     for (size_t i = 0; i < n; i++) {
-      bee[i].posX = prng.random8(0, cols);
-      bee[i].posY = prng.random8(0, rows);
+      bee[i].posX = SEGPRNG.random8(0, cols);
+      bee[i].posY = SEGPRNG.random8(0, rows);
       bee[i].aimed(cols, rows);
     }
   }
@@ -6607,6 +6623,7 @@ void mode_2Dplasmarotozoom() {
   if (!SEGENV.allocateData(dataSize)) FX_FALLBACK_STATIC; //allocation failed
   float *a = reinterpret_cast<float*>(SEGENV.data);
   byte *plasma = reinterpret_cast<byte*>(SEGENV.data+sizeof(float));
+  uint32_t row[FX_ROW_CHUNK]; // pixels of current row, written at once
 
   unsigned ms = strip.now/15;  
 
@@ -6623,13 +6640,16 @@ void mode_2Dplasmarotozoom() {
   float f       = (sin_t(*a/2)+((128-SEGMENT.intensity)/128.0f)+1.1f)/1.5f;  // scale factor
   float kosinus = cos_t(*a) * f;
   float sinus   = sin_t(*a) * f;
-  for (int i = 0; i < cols; i++) {
-    float u1 = i * kosinus;
-    float v1 = i * sinus;
-    for (int j = 0; j < rows; j++) {
-        byte u = abs8(u1 - j * sinus) % cols;
-        byte v = abs8(v1 + j * kosinus) % rows;
-        SEGMENT.setPixelColorXY(i, j, SEGMENT.color_from_palette(plasma[v*cols+u], false, PALETTE_SOLID_WRAP, 255));
+  // rotate in Q16.16 fixed point (faster than float on MCUs without FPU), stepping along the row replaces the multiplications
+  const q16_t qCos = q16_from_float(kosinus);
+  const q16_t qSin = q16_from_float(sinus);
+  for (int j = 0; j < rows; j++) {
+    q16_t u1 = -j * qSin; // i * cos - j * sin
+    q16_t v1 =  j * qCos; // i * sin + j * cos
+    for (int i = 0; i < cols; i++, u1 += qCos, v1 += qSin) {
+      byte u = abs8(q16_to_int(u1)) % cols;
+      byte v = abs8(q16_to_int(v1)) % rows;
+      setRowPixel(row, i, j, cols, SEGMENT.color_from_palette(plasma[v*cols+u], false, PALETTE_SOLID_WRAP, 255));
     }
   }
   *a -= 0.03f + float(SEGENV.speed-128)*0.0002f;  // rotation speed
@@ -7939,49 +7959,37 @@ void mode_2Doctopus() {
 
   const int cols = SEG_W;
   const int rows = SEG_H;
-  const auto XY = [&](int x, int y) { return (x%cols) + (y%rows) * cols; };
   const uint8_t mapp = 180 / MAX(cols,rows);
 
-  typedef struct {
-    uint8_t angle;
-    uint8_t radius;
-  } map_t;
+  if (!SEGENV.allocateData(2)) FX_FALLBACK_STATIC; //allocation failed
 
-  const size_t dataSize = SEGMENT.width() * SEGMENT.height() * sizeof(map_t); // prevent reallocation if mirrored or grouped
-  if (!SEGENV.allocateData(dataSize + 2)) FX_FALLBACK_STATIC; //allocation failed
+  uint8_t *offsX = reinterpret_cast<uint8_t*>(SEGENV.data);
+  uint8_t *offsY = reinterpret_cast<uint8_t*>(SEGENV.data + 1);
 
-  map_t *rMap = reinterpret_cast<map_t*>(SEGENV.data);
-  uint8_t *offsX = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize);
-  uint8_t *offsY = reinterpret_cast<uint8_t*>(SEGENV.data + dataSize + 1);
-
-  // re-init if SEGMENT dimensions or offset changed
+  // restart if SEGMENT dimensions or offset changed
   if (SEGENV.call == 0 || SEGENV.aux0 != cols || SEGENV.aux1 != rows || SEGMENT.custom1 != *offsX || SEGMENT.custom2 != *offsY) {
     SEGENV.step = 0; // t
     SEGENV.aux0 = cols;
     SEGENV.aux1 = rows;
     *offsX = SEGMENT.custom1;
     *offsY = SEGMENT.custom2;
-    const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
-    const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
-    for (int x = 0; x < cols; x++) {
-      for (int y = 0; y < rows; y++) {
-        int dx = (x - C_X);
-        int dy = (y - C_Y);
-        rMap[XY(x, y)].angle  = int(40.7436f * atan2_t(dy, dx));  // avoid 128*atan2()/PI
-        rMap[XY(x, y)].radius = sqrtf(dx * dx + dy * dy) * mapp; //thanks Sutaburosu
-      }
-    }
   }
+  const int C_X = (cols / 2) + ((SEGMENT.custom1 - 128)*cols)/255;
+  const int C_Y = (rows / 2) + ((SEGMENT.custom2 - 128)*rows)/255;
+  const PolarMap *polar = SEGMENT.getPolarMap(C_X, C_Y); // angle & distance of each pixel, shared with other segments of same geometry
+  if (!polar) FX_FALLBACK_STATIC;
 
+  uint32_t row[FX_ROW_CHUNK]; // pixels of current row, written at once
   SEGENV.step += SEGMENT.speed / 32 + 1;  // 1-4 range
-  for (int x = 0; x < cols; x++) {
-    for (int y = 0; y < rows; y++) {
-      byte angle = rMap[XY(x,y)].angle;
-      byte radius = rMap[XY(x,y)].radius;
+  for (int y = 0; y < rows; y++) {
+    for (int x = 0; x < cols; x++) {
+      const unsigned i = polar->index(x, y);
+      byte angle = polar->angle[i];
+      byte radius = (polar->dist[i] * mapp) >> 4; //thanks Sutaburosu
       //CRGB c = CHSV(SEGENV.step / 2 - radius, 255, sin8_t(sin8_t((angle * 4 - radius) / 4 + SEGENV.step) + radius - SEGENV.step * 2 + angle * (SEGMENT.custom3/3+1)));
       unsigned intensity = sin8_t(sin8_t((angle * 4 - radius) / 4 + SEGENV.step/2) + radius - SEGENV.step + angle * (SEGMENT.custom3/4+1));
       //intensity = map((intensity*intensity) & 0xFFFF, 0, 65535, 0, 255); // add a bit of non-linearity for cleaner display -> no longer needed with proper gamma correction
-      SEGMENT.setPixelColorXY(x, y, ColorFromPalette(SEGPALETTE, SEGENV.step / 2 - radius, intensity));
+      setRowPixel(row, x, y, cols, ColorFromPalette(SEGPALETTE, SEGENV.step / 2 - radius, intensity));
     }
   }
 }
@@ -9741,7 +9749,8 @@ void mode_particleDancingShadows(void) {
       //emit particle
       //set the particle source position:
       PartSys->sources[0].source.x = position * PS_P_RADIUS_1D;
-      uint32_t partidx = PartSys->sprayEmit(PartSys->sources[0]);
+      int32_t partidx = PartSys->sprayEmit(PartSys->sources[0]);
+      if (partidx < 0) break; // no more particles available
       PartSys->particles[partidx].ttl = ttl;
       position++; //do the next pixel
     }
@@ -11033,7 +11042,7 @@ void WS2812FX::setupEffectData() {
   addEffect(FX_MODE_TWO_DOTS, &mode_two_dots, _data_FX_MODE_TWO_DOTS);
   addEffect(FX_MODE_FAIRYTWINKLE, &mode_fairytwinkle, _data_FX_MODE_FAIRYTWINKLE);
   addEffect(FX_MODE_RUNNING_DUAL, &mode_running_dual, _data_FX_MODE_RUNNING_DUAL);
-  #ifdef WLED_ENABLE_GIF
+  #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
   addEffect(FX_MODE_IMAGE, &mode_image, _data_FX_MODE_IMAGE);
   #endif
   addEffect(FX_MODE_TRICOLOR_CHASE, &mode_tricolor_chase, _data_FX_MODE_TRICOLOR_CHASE);
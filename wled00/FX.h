@@ -19,6 +19,7 @@
 #include <vector>
 #include "wled.h"
 #include "colors.h"
+#include "prng.h"
 #ifdef WLED_DEBUG
   // enable additional debug output
   #if defined(WLED_DEBUG_HOST)
@@ -73,6 +74,11 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define FPS_UNLIMITED    0
 
 // FPS calculation (can be defined as compile flag for debugging)
+// maximum time between bus updates if frame content did not change (keeps network receivers & refresh dependent LED chips alive)
+#ifndef STATIC_REFRESH_MS
+#define STATIC_REFRESH_MS 1000
+#endif
+
 #ifndef FPS_CALC_AVG
 #define FPS_CALC_AVG 7 // average FPS calculation over this many frames (moving average)
 #endif
@@ -102,11 +108,26 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / MAX_NUM_SEGMENTS)
 
+/* Segment data arena (opt-in with WLED_ENABLE_SEGMENT_ARENA): effect data is carved from a single MAX_SEGMENT_DATA block
+  (reserved on first use) instead of the heap, freed blocks are closed up by relocating live data between frames. Keeps heap
+  fragmentation caused by effect changes (playlists) at bay at the cost of a permanent reservation, so it is only worth it on
+  boards with PSRAM or plenty of free heap. Data that does not fit into the arena is allocated from the heap. */
+#ifdef WLED_ENABLE_SEGMENT_ARENA
+  #define WLED_SEGMENT_ARENA
+#endif
+
+/* Parallel effect rendering (dual core ESP32 only): independent segments are rendered by a worker task
+  on the other core while loop() renders the rest. Each render task draws with its own FxDrawContext. */
+#if defined(WLED_ENABLE_PARALLEL_FX) && (!defined(ARDUINO_ARCH_ESP32) || defined(CONFIG_FREERTOS_UNICORE))
+  #undef WLED_ENABLE_PARALLEL_FX // single core MCU
+#endif
+
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
 #define NUM_COLORS       3 /* number of colors per segment */
-#define SEGMENT          (*strip._currentSegment)
-#define SEGENV           (*strip._currentSegment)
+#define SEGMENT          (*Segment::draw().segment)
+#define SEGENV           (*Segment::draw().segment)
+#define SEGPRNG          (Segment::draw().prng)
 #define SEGCOLOR(x)      Segment::getCurrentColor(x)
 #define SEGPALETTE       Segment::getCurrentPalette()
 #define SEGLEN           Segment::vLength()
@@ -416,6 +437,56 @@ typedef enum mapping1D2D {
 
 class WS2812FX;
 class FontManager;
+class Segment;
+
+// drawing state of a render task, set up by WS2812FX::renderSegment() and Segment::beginDraw() for effect functions
+// loop() draws with Segment::_mainDraw, the parallel render task (WLED_ENABLE_PARALLEL_FX) with its own instance
+struct FxDrawContext {
+  Segment      *segment;             // current segment (SEGMENT & SEGENV)
+  uint8_t       segmentIndex;        // index of current segment (only valid while strip.isServicing())
+  bool          modeBlend;           // mode/effect blending semaphore (old effect of a transition is drawn)
+  unsigned      vLength;             // 1D dimension used for current effect
+  unsigned      vWidth, vHeight;     // 2D dimensions used for current effect
+  uint32_t      colors[NUM_COLORS];  // colors used for current effect (faster access from effect functions)
+  CRGBPalette16 palette;             // palette used for current effect (includes transition, used in color_from_palette())
+  PRNG          prng;                // SEGPRNG, loaded from/stored to segment around its effect call (same sequence on any task)
+};
+
+#ifndef WLED_SAVE_RAM
+#ifndef WLED_PALETTE_LUT_MIN_LEN
+  #ifdef ESP8266
+    #define WLED_PALETTE_LUT_MIN_LEN 256 // segments shorter than this use ColorFromPalette() directly
+  #else
+    #define WLED_PALETTE_LUT_MIN_LEN 64
+  #endif
+#endif
+// current palette of a segment expanded with LINEARBLEND (RGB, W=0), used in color_from_palette()
+// stored behind the pixel buffer (see Segment::pixelBufferSize()) so only 32 bit members (IRAM has no byte access)
+struct PaletteLUT {
+  uint32_t entry[256];
+  uint32_t source[sizeof(CRGBPalette16)/sizeof(uint32_t)]; // palette the entries were built from
+  uint32_t valid;                                          // 0 if entries were never built (buffer just allocated)
+};
+#endif
+
+#ifndef WLED_DISABLE_2D
+#ifndef WLED_MAX_POLAR_MAPS
+  #define WLED_MAX_POLAR_MAPS 4   // number of distinct geometries (size + centre) cached at the same time
+#endif
+// polar coordinates of all pixels of a virtual segment around a centre, shared by all effects using the same geometry
+// (see Segment::getPolarMap()); a single allocation holding the header followed by the tables
+struct PolarMap {
+  uint16_t  width, height;  // virtual segment size
+  int16_t   cx, cy;         // centre (pixel)
+  uint32_t  frame;          // frame in which the map was last used
+  uint32_t  time;           // millis() of last use
+  uint16_t *dist;           // [width*height] distance to centre, 12.4 fixed point
+  uint8_t  *angle;          // [width*height] angle around centre, 256 = full turn, 0 = +x, 64 = +y
+  uint8_t  *nx;             // [width] x normalized to 0-255
+  uint8_t  *ny;             // [height] y normalized to 0-255
+  inline unsigned index(unsigned x, unsigned y) const { return x + y * width; }
+};
+#endif
 
 // segment, 76 bytes
 class Segment {
@@ -483,18 +554,20 @@ class Segment {
         bool    _manualW  : 1;
       };
     };
+    mutable bool _dirty;              // pixel buffer changed since last show() (set by pixel setters, used to skip unchanged segments)
+    uint16_t _prngSeed;               // SEGPRNG state of this segment's effect
+    uint32_t _blendKey[5];            // parameters used by blendSegment() at last show() (see updateBlendKey())
 
     // static variables are use to speed up effect calculations by stashing common pre-calculated values
     static unsigned      _usedSegmentData;    // amount of data used by all segments
-    static unsigned      _vLength;            // 1D dimension used for current effect
-    static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
-    static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
-    static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+    static FxDrawContext _mainDraw;           // drawing state of loop() task
+    #ifdef WLED_ENABLE_PARALLEL_FX
+    static thread_local FxDrawContext *_draw; // drawing state of calling task (&_mainDraw unless set by render task)
+    #endif
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
     static uint16_t      _nextPaletteBlend;   // next due time for random palette morph (in millis())
-    static bool          _modeBlend;          // mode/effect blending semaphore
     // clipping rectangle used for blending
     static uint16_t      _clipStart, _clipStop;
     static uint8_t       _clipStartY, _clipStopY;
@@ -536,10 +609,21 @@ class Segment {
     inline static void addUsedSegmentData(int len) { Segment::_usedSegmentData = max(0, int(Segment::_usedSegmentData) + len); }  // clamp negative results to 0
 
     inline uint32_t *getPixels() const                              { return pixels; }
-    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
+  #ifndef WLED_SAVE_RAM
+    // pixel buffer of longer segments is followed by their expanded palette
+    static constexpr size_t pixelBufferSize(unsigned len)           { return len * sizeof(uint32_t) + (len >= WLED_PALETTE_LUT_MIN_LEN ? sizeof(PaletteLUT) : 0); }
+    inline PaletteLUT *paletteLUT() const                           { return pixels && length() >= WLED_PALETTE_LUT_MIN_LEN ? reinterpret_cast<PaletteLUT*>(pixels + length()) : nullptr; }
+    inline void     invalidatePaletteLUT() const                    { if (PaletteLUT *lut = paletteLUT()) lut->valid = 0; }
+  #else
+    static constexpr size_t pixelBufferSize(unsigned len)           { return len * sizeof(uint32_t); }
+    inline void     invalidatePaletteLUT() const                    {}
+  #endif
+    bool updateBlendKey();          // stores parameters affecting blendSegment(), returns true if they changed (dirty tracking in show())
+    inline void     markDirty() const                               { _dirty = true; } // for code writing to getPixels() directly
+    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { _dirty |= pixels[i] != c; pixels[i] = c; }
     inline uint32_t getPixelColorRaw(unsigned i) const              { return pixels[i]; };
   #ifndef WLED_DISABLE_2D
-    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; }
+    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; _dirty |= pixels[XY(x,y)] != c; pixels[XY(x,y)] = c; }
     inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
@@ -555,9 +639,9 @@ class Segment {
     inline uint16_t progress() const          { return isInTransition() ? _t->_progress : 0xFFFFU; } // relies on handleTransition()/updateTransitionProgress() to update progression variable
     inline Segment *getOldSegment() const     { return isInTransition() ? _t->_oldSegment : nullptr; }
 
-    inline static void modeBlend(bool blend)  { Segment::_modeBlend = blend; }  // for isPreviousMode()
+    inline static void modeBlend(bool blend)  { draw().modeBlend = blend; }  // for isPreviousMode()
     inline static void setClippingRect(int startX, int stopX, int startY = 0, int stopY = 1) { _clipStart = startX; _clipStop = stopX; _clipStartY = startY; _clipStopY = stopY; };
-    inline static bool isPreviousMode()       { return Segment::_modeBlend; }    // needed for determining CCT/opacity during non-TRANSITION_FADE transition
+    inline static bool isPreviousMode()       { return draw().modeBlend; }   // needed for determining CCT/opacity during non-TRANSITION_FADE transition
 
     static void handleRandomPalette();
 
@@ -595,11 +679,14 @@ class Segment {
     , _dataLen(0)
     , _default_palette(6)
     , _capabilities(0)
+    , _dirty(true)
+    , _prngSeed(hw_random16())
+    , _blendKey{0,0,0,0,0}
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
       // allocate render buffer (always entire segment), prefer PSRAM if DRAM is running low. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM)
-      pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+      pixels = static_cast<uint32_t*>(allocate_buffer(pixelBufferSize(length()), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
       if (!pixels) {
         DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
         extern byte errorFlag;
@@ -621,7 +708,7 @@ class Segment {
       #endif
       clearName();
       stopTransition();   // deallocate "_t" (transition) and with it "_segOld" note: _segOld has _t=null, see copy constructor
-      #ifdef WLED_ENABLE_GIF
+      #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
       endImagePlayback(this);
       #endif
       deallocateData();
@@ -632,7 +719,7 @@ class Segment {
     Segment& operator= (Segment &&orig) noexcept; // move assignment
 
 #ifdef WLED_DEBUG
-    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?length()*sizeof(uint32_t):0); }
+    size_t getSize() const { return sizeof(Segment) + (data?_dataLen:0) + (name?strlen(name):0) + (_t?sizeof(Transition):0) + (pixels?pixelBufferSize(length()):0); }
 #endif
 
     inline bool     getOption(uint8_t n)   const { return ((options >> n) & 0x01); }
@@ -651,13 +738,19 @@ class Segment {
     inline Segment &clearName()                  { p_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
 
-    inline static unsigned vLength()                       { return Segment::_vLength; }
-    inline static unsigned vWidth()                        { return Segment::_vWidth; }
-    inline static unsigned vHeight()                       { return Segment::_vHeight; }
-    inline static uint32_t getCurrentColor(unsigned i)     { return Segment::_currentColors[i<NUM_COLORS?i:0]; }
-    inline static const CRGBPalette16 &getCurrentPalette() { return Segment::_currentPalette; }
+    #ifdef WLED_ENABLE_PARALLEL_FX
+    inline static FxDrawContext &draw()                    { return *Segment::_draw; }
+    inline static void setDrawContext(FxDrawContext *ctx)  { Segment::_draw = ctx ? ctx : &Segment::_mainDraw; }
+    #else
+    inline static FxDrawContext &draw()                    { return Segment::_mainDraw; }
+    #endif
+    inline static unsigned vLength()                       { return draw().vLength; }
+    inline static unsigned vWidth()                        { return draw().vWidth; }
+    inline static unsigned vHeight()                       { return draw().vHeight; }
+    inline static uint32_t getCurrentColor(unsigned i)     { return draw().colors[i<NUM_COLORS?i:0]; }
+    inline static const CRGBPalette16 &getCurrentPalette() { return draw().palette; }
 
-    inline void setDrawDimensions() const { Segment::_vWidth = virtualWidth(); Segment::_vHeight = virtualHeight(); Segment::_vLength = virtualLength(); }
+    inline void setDrawDimensions() const { FxDrawContext &d = draw(); d.vWidth = virtualWidth(); d.vHeight = virtualHeight(); d.vLength = virtualLength(); }
 
     void    beginDraw(uint16_t prog = 0xFFFFU);         // set up parameters for current effect
     void    setGeometry(uint16_t i1, uint16_t i2, uint8_t grp=1, uint8_t spc=0, uint16_t ofs=UINT16_MAX, uint16_t i1Y=0, uint16_t i2Y=1, uint8_t m12=0);
@@ -675,6 +768,18 @@ class Segment {
     bool allocateData(size_t len);  // allocates effect data buffer in heap and clears it
     void deallocateData();          // deallocates (frees) effect data buffer from heap
     inline static unsigned getUsedSegmentData()            { return Segment::_usedSegmentData; }
+    #ifndef WLED_DISABLE_2D
+    static const PolarMap *getPolarMap(int cx, int cy); // polar map of current virtual segment size around cx,cy (nullptr if out of memory)
+    static void tidyPolarMaps();                 // frees polar maps no longer used (between frames only!)
+    #endif
+    #ifdef WLED_SEGMENT_ARENA
+    static void     compactData();               // closes gaps in data arena by relocating effect data (between frames only!)
+    static unsigned getDataArenaSize();          // size of data arena (0 if not reserved yet)
+    static unsigned getDataArenaLargestFree();   // largest data block that can be allocated without compaction
+    static uint8_t  getDataArenaFragmentation(); // free arena memory outside of largest free block (%)
+    static unsigned getDataArenaFailures();      // failed effect data allocations since boot
+    static unsigned getDataArenaCompactions();   // number of compactions since boot
+    #endif
     /**
       * Flags that before the next effect is calculated,
       * the internal segment state should be reset.
@@ -749,6 +854,8 @@ class Segment {
     #endif
     [[gnu::hot]] bool isPixelXYClipped(int x, int y) const;
     [[gnu::hot]] uint32_t getPixelColorXY(int x, int y) const;
+    [[gnu::hot]] void setPixelRowXY(int x, int y, const uint32_t *colors, unsigned count) const;  // write count pixels of row y starting at x
+    void setPixelBlockXY(int x, int y, unsigned w, unsigned h, const uint32_t *colors) const;    // write w*h pixels (row by row) with top-left corner at x,y
     // 2D support functions
     inline void blendPixelColorXY(uint16_t x, uint16_t y, uint32_t color, uint8_t blend) const { setPixelColorXY(x, y, color_blend(getPixelColorXY(x,y), color, blend)); }
     inline void blendPixelColorXY(uint16_t x, uint16_t y, CRGB c, uint8_t blend) const         { blendPixelColorXY(x, y, RGBW32(c.r,c.g,c.b,0), blend); }
@@ -786,6 +893,8 @@ class Segment {
     #endif
     inline bool isPixelXYClipped(int x, int y)                                    { return isPixelClipped(x); }
     inline uint32_t getPixelColorXY(int x, int y)                                 { return getPixelColor(x); }
+    inline void setPixelRowXY(int x, int y, const uint32_t *colors, unsigned count) const { for (unsigned i = 0; i < count; i++) setPixelColor(x + int(i), colors[i]); }
+    inline void setPixelBlockXY(int x, int y, unsigned w, unsigned h, const uint32_t *colors) const { for (unsigned j = 0; j < h; j++) setPixelRowXY(x, y, colors + j*w, w); }
     inline void blendPixelColorXY(uint16_t x, uint16_t y, uint32_t c, uint8_t blend) { blendPixelColor(x, c, blend); }
     inline void blendPixelColorXY(uint16_t x, uint16_t y, CRGB c, uint8_t blend)  { blendPixelColor(x, RGBW32(c.r,c.g,c.b,0), blend); }
     inline void addPixelColorXY(int x, int y, uint32_t color, bool preserveCR = true) { addPixelColor(x, color, preserveCR); }
@@ -812,6 +921,30 @@ class Segment {
   friend class ParticleSystem1D;
 };
 
+struct LedmapBinHeader; // compiled ledmap file header (see deserializeMap())
+
+#ifndef WLED_DISABLE_FX_PROFILE
+#define WLED_FX_PROFILE_WINDOW 10000 // ms, profile is reported for the last completed window
+// render time (us) of one segment stage within a profile window
+struct FxTiming {
+  uint32_t runs;
+  uint32_t totalUs;
+  uint32_t minUs;
+  uint32_t maxUs;
+  inline void add(uint32_t us) { runs++; totalUs += us; if (us < minUs) minUs = us; if (us > maxUs) maxUs = us; }
+  inline void reset()          { runs = totalUs = maxUs = 0; minUs = UINT32_MAX; }
+};
+// per segment profile (see WS2812FX::serializeProfile())
+struct FxProfile {
+  FxTiming fx;       // current effect function
+  FxTiming old;      // old effect function during transition
+  FxTiming blend;    // blendSegment()
+  uint32_t pixels;   // virtual pixels drawn by effect (last frame)
+  uint8_t  mode;     // effect of last frame
+  inline void reset() { fx.reset(); old.reset(); blend.reset(); }
+};
+#endif
+
 // main "strip" class (108 bytes)
 class WS2812FX {
   typedef void (*mode_ptr)(); // pointer to mode function
@@ -850,14 +983,33 @@ class WS2812FX {
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
       _triggered(false),
-      _segment_index(0),
+      _showPending(false),
+      _forceFullBlend(true),
       _mainSegment(0),
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
       customMappingSize(0),
+      _ledmapLoadTime(0),
+      _ledmapLoadHeap(0),
       _lastShow(0),
-      _lastServiceShow(0)
+      _lastServiceShow(0),
+      _lastBusShow(0),
+      _frameKey{0,0,0,0,0,0},
+      _skippedSegments(0),
+      _pixelsWritten(false),
+      _skippedPixels(0),
+      _effectTime(0),
+      _overlapTime(0)
+#ifndef WLED_DISABLE_FX_PROFILE
+      ,_profileStart(0)
+      ,_profileWindow(0)
+#endif
+#ifdef WLED_ENABLE_PARALLEL_FX
+      ,_fxWorker(nullptr)
+      ,_fxWorkerDone(nullptr)
+      ,_fxWorkerMask(0)
+#endif
     {
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
       _modeData.reserve(_modeCount); // allocate memory to prevent initial fragmentation (does not increase size())
@@ -866,6 +1018,10 @@ class WS2812FX {
     }
 
     ~WS2812FX() {
+#ifdef WLED_ENABLE_PARALLEL_FX
+      if (_fxWorker) vTaskDelete(_fxWorker);
+      if (_fxWorkerDone) vSemaphoreDelete(_fxWorkerDone);
+#endif
       p_free(_pixels);
       p_free(_pixelCCT); // just in case
       d_free(customMappingTable);
@@ -898,8 +1054,10 @@ class WS2812FX {
       setupEffectData(),                          // add default effects to the list; defined in FX.cpp
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
+    void renderSegment(Segment &seg, uint8_t index); // runs segment's effect (and old effect in transition) with draw context of calling task
     void setRealtimePixelColor(unsigned i, uint32_t c);
-    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
+    void setRealtimePixels(int start, const uint8_t *data, size_t count, unsigned channels); // bulk realtime ingest of RGB (3) or RGBW (4) byte data
+    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) { _pixels[n] = c; _pixelsWritten = true; } }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
                                                               { setPixelColor(n, RGBW32(r,g,b,w)); }
@@ -915,6 +1073,12 @@ class WS2812FX {
 
     void restartRuntime();
     void setTransitionMode(bool t);
+#ifdef WLED_ENABLE_ASYNC_SHOW
+    void flushShow();                                         // hands deferred frame to busses once they finished sending previous one
+#endif
+#ifdef WLED_ENABLE_FX_BENCHMARK
+    void benchmarkEffects(Print &out, unsigned width, unsigned height, unsigned frames, uint8_t fx = 255); // runs effects on private segment and prints CSV stats; defined in FX_bench.cpp
+#endif
 
     bool checkSegmentAlignment() const;
     bool hasRGBWBus() const;
@@ -927,6 +1091,7 @@ class WS2812FX {
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
     inline bool isSuspended() const          { return _suspend; }               // returns true if strip.service() execution is suspended
     inline bool needsUpdate() const          { return _triggered; }             // returns true if strip received a trigger() request
+    inline unsigned msToNextFrame() const    { unsigned long e = millis() - _lastServiceShow; return (_triggered || _targetFps == FPS_UNLIMITED || e >= _frametime) ? 0 : _frametime - e; } // ms until service() renders next frame
 
     // uint8_t paletteBlend;  // obsolete - use global paletteBlend instead of strip.paletteBlend
     uint8_t getActiveSegmentsNum() const;
@@ -938,7 +1103,7 @@ class WS2812FX {
     inline uint8_t getBrightness() const    { return _brightness; }       // returns current strip brightness
     inline static constexpr unsigned getMaxSegments() { return MAX_NUM_SEGMENTS; }  // returns maximum number of supported segments (fixed value)
     inline uint8_t getSegmentsNum() const   { return _segments.size(); }  // returns currently present segments
-    inline uint8_t getCurrSegmentId() const { return _segment_index; }    // returns current segment index (only valid while strip.isServicing())
+    inline uint8_t getCurrSegmentId() const { return Segment::draw().segmentIndex; } // returns current segment index (only valid while strip.isServicing())
     inline uint8_t getMainSegmentId() const { return _mainSegment; }      // returns main segment index
     inline uint8_t getTargetFps() const     { return _targetFps; }        // returns rough FPS value for las 2s interval
     inline uint8_t getModeCount() const     { return _modeCount; }        // returns number of registered modes/effects
@@ -960,6 +1125,15 @@ class WS2812FX {
     inline uint32_t getPixelColor(unsigned n) const { return (getMappedPixelIndex(n) < getLengthTotal()) ? _pixels[n] : 0; } // returns color of pixel n, black if out of (mapped) bounds
     inline uint32_t getPixelColorNoMap(unsigned n) const { return (n < getLengthTotal()) ? _pixels[n] : 0; } // ignores mapping table
     inline uint32_t getLastShow() const             { return _lastShow; }                 // returns millis() timestamp of last strip.show() call
+    inline uint8_t  getSkippedSegments() const      { return _skippedSegments; }          // returns number of unchanged segments not re-blended in last show()
+    inline uint32_t getSkippedPixels() const        { return _skippedPixels; }            // returns number of segment pixels not re-blended in last show()
+    inline uint32_t getEffectTime() const           { return _effectTime; }               // returns average time (us) spent in effect functions per frame
+    inline uint32_t getOverlapTime() const          { return _overlapTime; }              // returns average effect time (us) that overlapped with bus transmission
+    inline uint16_t getLedmapLoadTime() const       { return _ledmapLoadTime; }           // returns time (ms) it took to load last ledmap
+    inline uint32_t getLedmapLoadHeap() const       { return _ledmapLoadHeap; }           // returns peak heap (B) used while loading last ledmap
+#ifndef WLED_DISABLE_FX_PROFILE
+    void serializeProfile(JsonObject root) const;                                         // per segment effect/blend timing of last profile window
+#endif
 
     const char *getModeData(unsigned id = 0) const  { return (id && id < _modeCount) ? _modeData[id] : PSTR("Solid"); }
     inline const char **getModeDataSrc()            { return &(_modeData[0]); }           // vectors use arrays for underlying data
@@ -1013,8 +1187,6 @@ class WS2812FX {
       bool cctFromRgb   : 1;
     };
 
-    Segment *_currentSegment;
-
   private:
     uint32_t *_pixels;
     uint8_t  *_pixelCCT;
@@ -1036,9 +1208,10 @@ class WS2812FX {
       bool _isOffRefreshRequired : 1; //periodic refresh is required for the strip to remain off.
       bool _hasWhiteChannel      : 1;
       bool _triggered            : 1;
+      bool _showPending          : 1; // frame is in bus buffers but busses are still sending previous one (WLED_ENABLE_ASYNC_SHOW)
+      bool _forceFullBlend       : 1; // frame buffer was written directly (realtime), next show() blends all segments
     };
 
-    uint8_t _segment_index;
     uint8_t _mainSegment;
 
     uint8_t                  _modeCount;
@@ -1049,9 +1222,46 @@ class WS2812FX {
 
     uint16_t* customMappingTable;
     uint16_t  customMappingSize;
+    uint16_t  _ledmapLoadTime;      // duration of last deserializeMap() (ms)
+    uint32_t  _ledmapLoadHeap;      // peak heap usage during last deserializeMap() (B)
 
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
+    unsigned long _lastBusShow;     // last time pixels were sent to busses (may differ from _lastShow if frame was unchanged)
+
+    // dirty tracking (see show())
+    uint32_t _frameKey[6];          // global blend parameters (brightness, mapping, matrix, busses, ...) at last show()
+    uint8_t  _skippedSegments;      // segments not re-blended in last show()
+    mutable bool _pixelsWritten;    // frame buffer written by setPixelColor() (overlay drew into previous frame)
+    uint32_t _skippedPixels;        // segment pixels not re-blended in last show()
+
+    // pipelining stats (see service())
+    uint32_t _effectTime;           // time spent in effect functions (us, averaged)
+    uint32_t _overlapTime;          // part of _effectTime during which busses were still sending previous frame (us, averaged)
+
+#ifndef WLED_DISABLE_FX_PROFILE
+    // per segment profiling (see service(), renderSegment() and show()), indexed like _segments
+    std::vector<FxProfile> _profile;      // running window
+    std::vector<FxProfile> _profileLast;  // last completed window
+    unsigned long _profileStart;
+    uint32_t      _profileWindow;         // length of last completed window (ms)
+    void rollProfile(unsigned long now);
+#endif
+
+#ifdef WLED_ENABLE_PARALLEL_FX
+    TaskHandle_t      _fxWorker;      // render task on the other core
+    SemaphoreHandle_t _fxWorkerDone;  // given by render task when all of its segments are drawn
+    uint64_t          _fxWorkerMask;  // segments drawn by render task in current frame
+
+    static void fxWorkerTask(void *arg);
+    bool canRenderOnWorker(const Segment &seg) const;
+    uint64_t startWorker();
+    void waitForWorker();
+#endif
+    void paintPixels(size_t totalLen);
+    bool getBlendFootprint(const Segment &seg, uint16_t &x0, uint16_t &x1, uint16_t &y0, uint16_t &y1) const;
+    bool readCompiledMap(File &f, const LedmapBinHeader &hdr);
+    void writeCompiledMap(const char *fileName, size_t jsonSize, uint16_t width, uint16_t height, bool complete);
 
     friend class Segment;
 };
@@ -192,6 +192,31 @@ void IRAM_ATTR_YN Segment::setPixelColorXY(int x, int y, uint32_t col) const
   setPixelColorXYRaw(x, y, col);
 }
 
+// write a span of pixels of one row from a buffer; clipping is done once per span instead of per pixel
+// (mirroring, reversing, transposing and grouping are applied when the segment is blended into the frame)
+void IRAM_ATTR_YN Segment::setPixelRowXY(int x, int y, const uint32_t *colors, unsigned count) const
+{
+  if (!isActive() || (unsigned)y >= vHeight()) return; // not active or row outside of virtual segment
+  const int cols = vWidth();
+  if (x < 0) {
+    if (unsigned(-x) >= count) return;
+    colors += -x;
+    count  -= -x;
+    x = 0;
+  }
+  if (x >= cols) return;
+  if (count > unsigned(cols - x)) count = cols - x;
+  uint32_t *dst = pixels + x + y * cols;
+  if (memcmp(dst, colors, count * sizeof(uint32_t)) == 0) return; // unchanged, keep segment clean
+  memcpy(dst, colors, count * sizeof(uint32_t));
+  _dirty = true;
+}
+
+void Segment::setPixelBlockXY(int x, int y, unsigned w, unsigned h, const uint32_t *colors) const
+{
+  for (unsigned j = 0; j < h; j++, colors += w) setPixelRowXY(x, y + j, colors, w);
+}
+
 #ifdef WLED_USE_AA_PIXELS
 // anti-aliased version of setPixelColorXY()
 void Segment::setPixelColorXY(float x, float y, uint32_t col, bool aa) const
@@ -0,0 +1,130 @@
+#include "wled.h"
+
+#ifdef WLED_ENABLE_FX_BENCHMARK
+
+/*
+ * Render engine benchmark
+ *
+ * Runs every registered effect for a fixed number of frames on a private (off-screen) segment
+ * and reports throughput and memory footprint as CSV. Used to catch per-effect regressions and
+ * to compare 1D vs. 2D cost of the same effect without touching the live segment setup.
+ *
+ * Triggered via JSON API: {"fxbench":{"w":32,"h":16,"n":200}} -> results are written to /fxbench.csv
+ * Leave out "h" (or use 1) for a 1D run. Effect time advances by one frame time per frame so
+ * time-based effects animate as they would on a live strip.
+ */
+
+// CSV columns: id,name,dim,w,h,frames,us,fps,ns/px,data,heap
+static void printBenchHeader(Print &out) {
+  out.println(F("id,name,dim,w,h,frames,us,fps,nspx,data,heap"));
+}
+
+static void printBenchName(Print &out, const char *modeData) {
+  // print effect name (up to '@') from effect metadata string (in PROGMEM on ESP8266)
+  for (size_t j = 0; j < 32; j++) {
+    char c = pgm_read_byte(modeData + j);
+    if (c == '\0' || c == '@') break;
+    if (c != ',') out.write(c); // keep CSV parseable
+  }
+}
+
+// returns 1 or 2 (as defined in effect metadata flags), 0 if effect has no dimension info
+static uint8_t getBenchDimension(const char *modeData) {
+  // flags follow 3rd ';' in metadata string ("name@sliders;colors;palette;flags;defaults")
+  unsigned semicolons = 0;
+  for (size_t j = 0; j < 256; j++) {
+    char c = pgm_read_byte(modeData + j);
+    if (c == '\0') break;
+    if (c == ';') { semicolons++; continue; }
+    if (semicolons == 3) {
+      if (c == '2') return 2;
+      if (c == '1') return 1;
+    } else if (semicolons > 3) break;
+  }
+  return 0;
+}
+
+/*
+ * Benchmark all effects (or a single one) on a private segment
+ * @param out     destination for CSV output (Serial, File, ...)
+ * @param width   segment width (1D length)
+ * @param height  segment height (1 for 1D)
+ * @param frames  number of frames rendered per effect
+ * @param fx      single effect to benchmark, 255 for all
+ * WARNING: must be called from loop() context, blocks for (frames * modeCount) effect calls
+ */
+void WS2812FX::benchmarkEffects(Print &out, unsigned width, unsigned height, unsigned frames, uint8_t fx) {
+  if (width == 0 || height == 0 || frames == 0) return;
+  #ifdef WLED_DISABLE_2D
+  height = 1;
+  #endif
+  if (width * height > MAX_LEDS) return;
+
+  waitForIt();          // let current frame finish
+  bool wasSuspended = _suspend;
+  suspend();            // prevent service() from interfering (async web handlers)
+
+  // do not create transitions or UI/UDP notifications while switching effects
+  uint16_t orgTransition = _transitionDur;
+  bool orgStateChanged = stateChanged;
+  unsigned long orgNow = now;
+  _transitionDur = 0;
+
+  // include blending into frame buffer if the benchmark segment fits into the current setup
+  bool doBlend = _pixels && (height == 1 ? width <= getLengthTotal() : (isMatrix && width <= Segment::maxWidth && height <= Segment::maxHeight));
+
+  printBenchHeader(out);
+  for (unsigned m = (fx < _modeCount ? fx : 0); m < (fx < _modeCount ? fx + 1U : _modeCount); m++) {
+    if (strncmp_P("RSVD", getModeData(m), 4) == 0) continue;
+
+    Segment seg(0, width, 0, height);
+    if (!seg.isActive()) break; // no RAM for pixel buffer, no point in continuing
+    seg.refreshLightCapabilities(); // RGB capability decides if palettes are used
+    for (unsigned c = 0; c < NUM_COLORS; c++) seg.colors[c] = getMainSegment().colors[c];
+    seg.setMode(m, true);
+    seg.resetIfRequired();
+
+    size_t heapStart = getFreeHeapSize();
+    size_t heapLow   = heapStart;
+    size_t dataStart = Segment::getUsedSegmentData();
+    size_t dataHigh  = dataStart;
+
+    now = 0;
+    unsigned long t0 = micros();
+    for (unsigned f = 0; f < frames; f++) {
+      seg.beginDraw();
+      Segment::draw().segment = &seg;
+      _mode[m]();
+      seg.call++;
+      if (doBlend) blendSegment(seg);
+      now += FRAMETIME_FIXED;
+      size_t heap = getFreeHeapSize();
+      if (heap < heapLow) heapLow = heap;
+      if (Segment::getUsedSegmentData() > dataHigh) dataHigh = Segment::getUsedSegmentData();
+      if ((f & 0x0F) == 0x0F) yield(); // keep WiFi alive on ESP8266
+    }
+    unsigned long us = micros() - t0;
+    Segment::draw().segment = &_segments[0];
+
+    unsigned pixels = seg.length();
+    out.printf_P(PSTR("%u,"), m);
+    printBenchName(out, getModeData(m));
+    out.printf_P(PSTR(",%u,%u,%u,%u,%lu,%u,%u,%u,%u\n"),
+      (unsigned)getBenchDimension(getModeData(m)), width, height, frames, us,
+      us ? (unsigned)((1000000ULL * frames) / us) : 0,
+      (unsigned)((1000ULL * us) / ((uint64_t)frames * pixels)),
+      (unsigned)(dataHigh - dataStart),
+      (unsigned)(heapStart - heapLow));
+    yield();
+  } // seg is destroyed here (frees pixel buffer and effect data)
+
+  Segment::draw().segment      = &_segments[0];
+  Segment::draw().segmentIndex = 0;
+  _transitionDur  = orgTransition;
+  stateChanged    = orgStateChanged;
+  now             = orgNow;
+  if (!wasSuspended) resume();
+  trigger(); // frame buffer was overwritten, redraw
+}
+
+#endif // WLED_ENABLE_FX_BENCHMARK
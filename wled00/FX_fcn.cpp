@@ -38,22 +38,301 @@ static_assert(MAX_NUM_SEGMENTS >= WLED_MAX_BUSSES, "Max segments must be at leas
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
-unsigned      Segment::_vLength           = 0;
-unsigned      Segment::_vWidth            = 0;
-unsigned      Segment::_vHeight           = 0;
-uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
-CRGBPalette16 Segment::_currentPalette    = CRGBPalette16();
+FxDrawContext Segment::_mainDraw          = FxDrawContext();
+#ifdef WLED_ENABLE_PARALLEL_FX
+thread_local FxDrawContext *Segment::_draw = &Segment::_mainDraw; // only a pointer per task, render task points it to its own context
+#endif
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
 uint16_t      Segment::_nextPaletteBlend  = 0; // in millis
 
-bool     Segment::_modeBlend = false;
 uint16_t Segment::_clipStart = 0;
 uint16_t Segment::_clipStop = 0;
 uint8_t  Segment::_clipStartY = 0;
 uint8_t  Segment::_clipStopY = 1;
 
+#ifdef WLED_ENABLE_PARALLEL_FX
+// effect data may be (re)allocated by effects running on either render task
+// mutex is created on first use (thread safe static initialisation), before any render task can allocate concurrently
+static SemaphoreHandle_t segmentDataMutex() {
+  static SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+  return mutex;
+}
+struct SegmentDataLock {
+  SemaphoreHandle_t mutex;
+  SegmentDataLock() : mutex(segmentDataMutex()) { if (mutex) xSemaphoreTake(mutex, portMAX_DELAY); }
+  ~SegmentDataLock() { if (mutex) xSemaphoreGive(mutex); }
+};
+#define LOCK_SEGMENT_DATA() SegmentDataLock segmentDataLock
+#else
+#define LOCK_SEGMENT_DATA()
+#endif
+
+#ifdef WLED_SEGMENT_ARENA
+// Segment data arena
+// Each block is prefixed with a header holding its size and the address of the owning Segment::data pointer,
+// so live blocks can be slid down over freed ones (compactData()) with their owners fixed up accordingly.
+// Blocks are 8 byte aligned and only ever relocated while no effect is running.
+struct ArenaBlock {
+  uint32_t size;   // including header
+  byte   **owner;  // nullptr if block is free
+};
+#define ARENA_ALIGN(x) (((x) + 7U) & ~7U)
+#define ARENA_HDR      ARENA_ALIGN(sizeof(ArenaBlock))
+
+static struct {
+  byte    *base;        // reserved on first allocation
+  uint32_t top;         // end of last block (everything above is free)
+  uint32_t holes;       // freed bytes below top
+  uint32_t failed;      // failed allocations
+  uint32_t compactions;
+  bool     noReserve;   // reservation failed, heap is used instead (not retried)
+} arena = {nullptr, 0, 0, 0, 0, false};
+
+static inline ArenaBlock *arenaBlock(uint32_t offset)   { return reinterpret_cast<ArenaBlock*>(arena.base + offset); }
+static inline bool        arenaContains(const byte *p)  { return arena.base && p >= arena.base && p < arena.base + MAX_SEGMENT_DATA; }
+
+// merges adjacent free blocks, trims free blocks at the top and recounts holes
+static void arenaTidy() {
+  uint32_t off = 0, lastUsedEnd = 0;
+  arena.holes = 0;
+  while (off < arena.top) {
+    ArenaBlock *b = arenaBlock(off);
+    if (!b->owner) {
+      while (off + b->size < arena.top && !arenaBlock(off + b->size)->owner) b->size += arenaBlock(off + b->size)->size;
+      arena.holes += b->size;
+    } else lastUsedEnd = off + b->size;
+    off += b->size;
+  }
+  arena.holes -= arena.top - lastUsedEnd; // trailing free block is not a hole
+  arena.top = lastUsedEnd;
+}
+
+static byte *arenaAlloc(size_t len, byte **owner) {
+  if (!arena.base) {
+    if (arena.noReserve) return nullptr;
+    arena.base = static_cast<byte*>(allocate_buffer(MAX_SEGMENT_DATA, BFRALLOC_PREFER_DRAM));
+    if (!arena.base) {
+      arena.noReserve = true;
+      DEBUG_PRINTF_P(PSTR("Segment data arena could not be reserved (%uB), using heap.\n"), (unsigned)MAX_SEGMENT_DATA);
+      return nullptr;
+    }
+    DEBUG_PRINTF_P(PSTR("Segment data arena reserved: %uB\n"), (unsigned)MAX_SEGMENT_DATA);
+  }
+  const uint32_t need = ARENA_HDR + ARENA_ALIGN(len);
+  ArenaBlock *b = nullptr;
+  if (arena.holes >= need) { // first fit into a freed block
+    for (uint32_t off = 0; off < arena.top; off += arenaBlock(off)->size) {
+      ArenaBlock *hole = arenaBlock(off);
+      if (hole->owner || hole->size < need) continue;
+      if (hole->size - need >= 2*ARENA_HDR) { // split, remainder stays free
+        ArenaBlock *rest = arenaBlock(off + need);
+        rest->size  = hole->size - need;
+        rest->owner = nullptr;
+        hole->size  = need;
+      }
+      arena.holes -= hole->size;
+      b = hole;
+      break;
+    }
+  }
+  if (!b && arena.top + need <= MAX_SEGMENT_DATA) {
+    b = arenaBlock(arena.top);
+    b->size = need;
+    arena.top += need;
+  }
+  if (!b) return nullptr;
+  b->owner = owner;
+  byte *p = reinterpret_cast<byte*>(b) + ARENA_HDR;
+  memset(p, 0, b->size - ARENA_HDR);
+  return p;
+}
+
+static void arenaFree(byte *p) {
+  ArenaBlock *b = reinterpret_cast<ArenaBlock*>(p - ARENA_HDR);
+  b->owner = nullptr;
+  arenaTidy();
+}
+
+// a Segment moved in memory, its data pointer lives elsewhere now
+static inline void arenaSetOwner(byte **owner) {
+  if (arenaContains(*owner)) reinterpret_cast<ArenaBlock*>(*owner - ARENA_HDR)->owner = owner;
+}
+
+// slide live blocks down over freed ones, must not be called while effects are running
+static void arenaCompact() {
+  uint32_t dst = 0;
+  for (uint32_t off = 0; off < arena.top; ) {
+    ArenaBlock *b = arenaBlock(off);
+    const uint32_t size = b->size;
+    if (b->owner) {
+      if (dst != off) {
+        memmove(arena.base + dst, b, size);
+        b = arenaBlock(dst);
+        *b->owner = arena.base + dst + ARENA_HDR;
+      }
+      dst += size;
+    }
+    off += size;
+  }
+  DEBUG_PRINTF_P(PSTR("Segment data arena compacted: %u -> %uB\n"), (unsigned)arena.top, (unsigned)dst);
+  arena.top   = dst;
+  arena.holes = 0;
+  arena.compactions++;
+}
+
+void Segment::compactData() {
+  if (!arena.holes) return;
+  LOCK_SEGMENT_DATA(); // render task may allocate data
+  arenaCompact();
+}
+
+unsigned Segment::getDataArenaSize()        { return arena.base ? MAX_SEGMENT_DATA : 0; }
+unsigned Segment::getDataArenaFailures()    { return arena.failed; }
+unsigned Segment::getDataArenaCompactions() { return arena.compactions; }
+
+unsigned Segment::getDataArenaLargestFree() {
+  if (!arena.base) return 0;
+  uint32_t largest = MAX_SEGMENT_DATA - arena.top;
+  for (uint32_t off = 0; off < arena.top; off += arenaBlock(off)->size) {
+    const ArenaBlock *b = arenaBlock(off);
+    if (!b->owner && b->size > largest) largest = b->size;
+  }
+  return largest > ARENA_HDR ? largest - ARENA_HDR : 0;
+}
+
+uint8_t Segment::getDataArenaFragmentation() {
+  if (!arena.base) return 0;
+  const uint32_t free = MAX_SEGMENT_DATA - arena.top + arena.holes;
+  const uint32_t largest = getDataArenaLargestFree() + ARENA_HDR;
+  return free > largest ? (100 * (free - largest)) / free : 0;
+}
+#endif
+
+// bytes accounted against MAX_SEGMENT_DATA for an effect data buffer of len bytes (arena header and alignment included)
+static inline int dataFootprint(size_t len) {
+  #ifdef WLED_SEGMENT_ARENA
+  return len ? ARENA_HDR + ARENA_ALIGN(len) : 0;
+  #else
+  return len;
+  #endif
+}
+
+#ifndef WLED_DISABLE_2D
+// Polar map cache
+// Radial effects need angle and distance of each pixel to a centre. Maps are computed on first request for a
+// given virtual size and centre and shared by all segments asking for the same geometry. A map is only replaced
+// if it was not used in the current frame (effects on the other render task may still hold it) and freed
+// once it has not been used for a while (i.e. geometry or effect changed).
+// Maps are accounted against MAX_SEGMENT_DATA like effect data.
+#define POLAR_MAP_TTL 2000 // ms
+
+static PolarMap *polarMaps[WLED_MAX_POLAR_MAPS] = {nullptr};
+static uint32_t  polarFrame = 0;
+
+static inline size_t polarMapSize(unsigned w, unsigned h) {
+  return sizeof(PolarMap) + w * h * (sizeof(uint16_t) + sizeof(uint8_t)) + w + h;
+}
+
+static PolarMap *createPolarMap(unsigned w, unsigned h, int cx, int cy) {
+  const size_t len = w * h;
+  const size_t size = polarMapSize(w, h);
+  PolarMap *map = static_cast<PolarMap*>(p_malloc(size));
+  if (!map) return nullptr;
+  map->width  = w;
+  map->height = h;
+  map->cx     = cx;
+  map->cy     = cy;
+  map->dist   = reinterpret_cast<uint16_t*>(map + 1);
+  map->angle  = reinterpret_cast<uint8_t*>(map->dist + len);
+  map->nx     = map->angle + len;
+  map->ny     = map->nx + w;
+  for (unsigned y = 0; y < h; y++) {
+    const int dy = y - cy;
+    for (unsigned x = 0; x < w; x++) {
+      const int dx = x - cx;
+      const unsigned i = map->index(x, y);
+      map->angle[i] = int(40.7436f * atan2_t(dy, dx)); // 128/PI
+      map->dist[i]  = min(sqrtf(dx * dx + dy * dy) * 16.0f, 65535.0f);
+    }
+  }
+  for (unsigned x = 0; x < w; x++) map->nx[x] = w > 1 ? x * 255 / (w - 1) : 0;
+  for (unsigned y = 0; y < h; y++) map->ny[y] = h > 1 ? y * 255 / (h - 1) : 0;
+  DEBUGFX_PRINTF_P(PSTR("Polar map %ux%u @ %d,%d created.\n"), w, h, cx, cy);
+  return map;
+}
+
+// frees maps not used in the current frame so effect data can use their budget, returns bytes released
+// (caller must hold the segment data lock)
+#ifndef BOARD_HAS_PSRAM
+static int releaseIdlePolarMaps() {
+  int released = 0;
+  for (int i = 0; i < WLED_MAX_POLAR_MAPS; i++) {
+    if (polarMaps[i] && polarMaps[i]->frame != polarFrame) {
+      released += polarMapSize(polarMaps[i]->width, polarMaps[i]->height);
+      p_free(polarMaps[i]);
+      polarMaps[i] = nullptr;
+    }
+  }
+  return released;
+}
+#endif
+
+const PolarMap *Segment::getPolarMap(int cx, int cy) {
+  const unsigned w = vWidth(), h = vHeight();
+  LOCK_SEGMENT_DATA(); // effects on both render tasks may ask for maps
+  int slot = -1;
+  for (int i = 0; i < WLED_MAX_POLAR_MAPS; i++) {
+    PolarMap *map = polarMaps[i];
+    if (map && map->width == w && map->height == h && map->cx == cx && map->cy == cy) {
+      map->frame = polarFrame;
+      map->time  = millis();
+      return map;
+    }
+    if (!map) {
+      if (slot < 0 || polarMaps[slot]) slot = i; // prefer empty slot
+      continue;
+    }
+    if (map->frame == polarFrame) continue;      // may be in use by an effect on the other render task
+    if (slot < 0 || (polarMaps[slot] && int32_t(map->time - polarMaps[slot]->time) < 0)) slot = i; // least recently used
+  }
+  if (slot < 0) return nullptr; // all maps in use by this frame
+  if (polarMaps[slot]) {
+    addUsedSegmentData(-int(polarMapSize(polarMaps[slot]->width, polarMaps[slot]->height)));
+    p_free(polarMaps[slot]);
+    polarMaps[slot] = nullptr;
+  }
+  // limit to MAX_SEGMENT_DATA if there is no PSRAM (same as effect data)
+  #ifndef BOARD_HAS_PSRAM
+  if (getUsedSegmentData() + polarMapSize(w, h) > MAX_SEGMENT_DATA) {
+    DEBUG_PRINTF_P(PSTR("SegmentData limit reached: polar map %ux%u (%u/%u)\n"), w, h, (unsigned)polarMapSize(w, h), getUsedSegmentData());
+    errorFlag = ERR_NORAM;
+    return nullptr;
+  }
+  #endif
+  polarMaps[slot] = createPolarMap(w, h, cx, cy);
+  if (polarMaps[slot]) {
+    addUsedSegmentData(polarMapSize(w, h));
+    polarMaps[slot]->frame = polarFrame;
+    polarMaps[slot]->time  = millis();
+  }
+  return polarMaps[slot];
+}
+
+void Segment::tidyPolarMaps() {
+  polarFrame++;
+  for (int i = 0; i < WLED_MAX_POLAR_MAPS; i++) {
+    if (polarMaps[i] && millis() - polarMaps[i]->time > POLAR_MAP_TTL) {
+      LOCK_SEGMENT_DATA(); // effect data may be allocated by the other render task
+      addUsedSegmentData(-int(polarMapSize(polarMaps[i]->width, polarMaps[i]->height)));
+      p_free(polarMaps[i]);
+      polarMaps[i] = nullptr;
+    }
+  }
+}
+#endif
+
 // copy constructor
 Segment::Segment(const Segment &orig) {
   //DEBUG_PRINTF_P(PSTR("-- Copy segment constructor: %p -> %p\n"), &orig, this);
@@ -66,9 +345,11 @@ Segment::Segment(const Segment &orig) {
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.pixels) {
     // allocate pixel buffer: prefer IRAM/PSRAM
-    pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+    pixels = static_cast<uint32_t*>(allocate_buffer(pixelBufferSize(orig.length()), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
     if (pixels) {
       memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
+      invalidatePaletteLUT();
+      _dirty = true;
       if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
       if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
     } else {
@@ -83,6 +364,9 @@ Segment::Segment(const Segment &orig) {
 Segment::Segment(Segment &&orig) noexcept {
   //DEBUG_PRINTF_P(PSTR("-- Move segment constructor: %p -> %p\n"), &orig, this);
   memcpy((void*)this, (void*)&orig, sizeof(Segment));
+  #ifdef WLED_SEGMENT_ARENA
+  arenaSetOwner(&data);
+  #endif
   orig._t   = nullptr; // old segment cannot be in transition any more
   orig.name = nullptr;
   orig.data = nullptr;
@@ -109,9 +393,11 @@ Segment& Segment::operator= (const Segment &orig) {
     // copy source data
     if (orig.pixels) {
       // allocate pixel buffer: prefer IRAM/PSRAM
-      pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+      pixels = static_cast<uint32_t*>(allocate_buffer(pixelBufferSize(orig.length()), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
       if (pixels) {
         memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
+        invalidatePaletteLUT();
+        _dirty = true;
         if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
         if (orig.data) { if (allocateData(orig._dataLen)) memcpy(data, orig.data, orig._dataLen); }
       } else {
@@ -134,6 +420,9 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     p_free(pixels);   // free old pixel buffer
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
+    #ifdef WLED_SEGMENT_ARENA
+    arenaSetOwner(&data);
+    #endif
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
@@ -157,31 +446,54 @@ bool Segment::allocateData(size_t len) {
     else
       return true;
   }
+  LOCK_SEGMENT_DATA(); // released when leaving function
   //DEBUG_PRINTF_P(PSTR("--   Allocating data (%d): %p\n"), len, this);
   // limit to MAX_SEGMENT_DATA if there is no PSRAM, otherwise prefer functionality over speed
   #ifndef BOARD_HAS_PSRAM
-  if (Segment::getUsedSegmentData() + len - _dataLen > MAX_SEGMENT_DATA) {
+  #ifndef WLED_DISABLE_2D
+  if (int(Segment::getUsedSegmentData()) + dataFootprint(len) - dataFootprint(_dataLen) > MAX_SEGMENT_DATA)
+    addUsedSegmentData(-releaseIdlePolarMaps()); // effect data takes precedence over cached polar maps
+  #endif
+  if (int(Segment::getUsedSegmentData()) + dataFootprint(len) - dataFootprint(_dataLen) > MAX_SEGMENT_DATA) {
     // not enough memory
     DEBUG_PRINTF_P(PSTR("SegmentData limit reached: %d/%d\n"), len, Segment::getUsedSegmentData());
+    #ifdef WLED_SEGMENT_ARENA
+    arena.failed++;
+    #endif
     errorFlag = ERR_NORAM;
     return false;
   }
   #endif
 
   if (data) {
+    #ifdef WLED_SEGMENT_ARENA
+    if (arenaContains(data)) arenaFree(data); else
+    #endif
     d_free(data); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
-    Segment::addUsedSegmentData(-_dataLen); // subtract buffer size
+    Segment::addUsedSegmentData(-dataFootprint(_dataLen)); // subtract buffer size
   }
 
+  #ifdef WLED_SEGMENT_ARENA
+  data = arenaAlloc(len, &data);
+  #ifndef WLED_ENABLE_PARALLEL_FX
+  // no other effect can be running: close gaps right away instead of waiting for next frame
+  if (!data && arena.holes) { arenaCompact(); data = arenaAlloc(len, &data); }
+  #endif
+  if (!data) data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // arena is full or could not be reserved
+  #else
   data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed
+  #endif
 
   if (data) {
-    Segment::addUsedSegmentData(len);
+    Segment::addUsedSegmentData(dataFootprint(len));
     _dataLen = len;
     //DEBUG_PRINTF_P(PSTR("---  Allocated data (%p): %d/%d -> %p\n"), this, len, Segment::getUsedSegmentData(), data);
     return true;
   }
   // allocation failed
+  #ifdef WLED_SEGMENT_ARENA
+  arena.failed++;
+  #endif
   DEBUG_PRINTLN(F("!!! Allocation failed. !!!"));
   errorFlag = ERR_NORAM;
   return false;
@@ -189,14 +501,18 @@ bool Segment::allocateData(size_t len) {
 
 void Segment::deallocateData() {
   if (!data) { _dataLen = 0; return; }
+  LOCK_SEGMENT_DATA(); // released when leaving function
   if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
     //DEBUG_PRINTF_P(PSTR("---  Released data (%p): %d/%d -> %p\n"), this, _dataLen, Segment::getUsedSegmentData(), data);
+    #ifdef WLED_SEGMENT_ARENA
+    if (arenaContains(data)) arenaFree(data); else
+    #endif
     d_free(data);
   } else {
     DEBUG_PRINTF_P(PSTR("---- Released data (%p): inconsistent UsedSegmentData (%d/%d), cowardly refusing to free nothing.\n"), this, _dataLen, Segment::getUsedSegmentData());
   }
   data = nullptr;
-  Segment::addUsedSegmentData(_dataLen <= Segment::getUsedSegmentData() ? -_dataLen : -Segment::getUsedSegmentData());
+  Segment::addUsedSegmentData(dataFootprint(_dataLen) <= int(Segment::getUsedSegmentData()) ? -dataFootprint(_dataLen) : -int(Segment::getUsedSegmentData()));
   _dataLen = 0;
 }
 
@@ -216,9 +532,10 @@ void Segment::resetIfRequired() {
     DEBUG_PRINTF_P(PSTR("-- Segment %p reset, data cleared\n"), this);
   }
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
+  _dirty = true;
   step = 0; call = 0; aux0 = 0; aux1 = 0;
   reset = false;
-  #ifdef WLED_ENABLE_GIF
+  #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
   endImagePlayback(this);
   #endif
 }
@@ -398,35 +715,66 @@ uint8_t Segment::currentBri() const {
   return curBri;
 }
 
+// stores all parameters used by WS2812FX::blendSegment() (except pixel content), returns true if any of them changed since last call
+bool Segment::updateBlendKey() {
+  const uint32_t key[] = {
+    uint32_t(start)  | (uint32_t(stop)  << 16),
+    uint32_t(startY) | (uint32_t(stopY) << 16),
+    uint32_t(offset) | (uint32_t(options & ~(SELECTED | RESET_REQ | FROZEN)) << 16), // selection, reset & freeze do not change appearance
+    uint32_t(grouping) | (uint32_t(spacing) << 8) | (uint32_t(currentBri()) << 16) | (uint32_t(currentCCT()) << 24),
+    uint32_t(blendMode) | (uint32_t(isActive()) << 8) | (uint32_t(isInTransition()) << 9)
+  };
+  static_assert(sizeof(key) == sizeof(_blendKey), "blend key size mismatch");
+  if (memcmp(key, _blendKey, sizeof(key)) == 0) return false;
+  memcpy(_blendKey, key, sizeof(key));
+  return true;
+}
+
 // pre-calculate drawing parameters for faster access (based on the idea from @softhack007 from MM fork)
 // and blends colors and palettes if necessary
 // prog is the progress of the transition (0-65535) and is passed to the function as it may be called in the context of old segment
 // which does not have transition structure
 void Segment::beginDraw(uint16_t prog) {
+  FxDrawContext &d = draw();
   setDrawDimensions();
-  // load colors into _currentColors
-  for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = colors[i];
-  // load palette into _currentPalette
-  loadPalette(Segment::_currentPalette, palette);
+  // load colors into current colors
+  for (unsigned i = 0; i < NUM_COLORS; i++) d.colors[i] = colors[i];
+  // load palette into current palette
+  loadPalette(d.palette, palette);
   if (isInTransition() && prog < 0xFFFFU && blendingStyle == TRANSITION_FADE) {
     // blend colors
-    for (unsigned i = 0; i < NUM_COLORS; i++) _currentColors[i] = color_blend16(_t->_colors[i], colors[i], prog);
+    for (unsigned i = 0; i < NUM_COLORS; i++) d.colors[i] = color_blend16(_t->_colors[i], colors[i], prog);
     // blend palettes
     // there are about 255 blend passes of 48 "blends" to completely blend two palettes (in _dur time)
     // minimum blend time is 100ms maximum is 65535ms
     #ifndef WLED_SAVE_RAM
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU) - _t->_prevPaletteBlends;
     if (noOfBlends > 255) noOfBlends = 255; // safety check
-    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, Segment::_currentPalette, 48);
-    Segment::_currentPalette = _t->_palT; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, d.palette, 48);
+    d.palette = _t->_palT; // copy transitioning/temporary palette
     #else
     unsigned noOfBlends = ((255U * prog) / 0xFFFFU);
     CRGBPalette16 tmpPalette;
     loadPalette(tmpPalette, _t->_palette);
-    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, Segment::_currentPalette, 48);
-    Segment::_currentPalette = tmpPalette; // copy transitioning/temporary palette
+    for (unsigned i = 0; i < noOfBlends; i++) nblendPaletteTowardPalette(tmpPalette, d.palette, 48);
+    d.palette = tmpPalette; // copy transitioning/temporary palette
     #endif
   }
+  #ifndef WLED_SAVE_RAM
+  // expand palette for color_from_palette() if it changed (palette, segment colors, transition or random palette blending)
+  if (PaletteLUT *lut = paletteLUT()) {
+    constexpr unsigned words = sizeof(lut->source)/sizeof(uint32_t);
+    uint32_t source[words];
+    memcpy(source, &d.palette, sizeof(source)); // LUT may be in IRAM: compare and copy 32 bit words only
+    bool changed = !lut->valid;
+    for (unsigned i = 0; i < words && !changed; i++) changed = lut->source[i] != source[i];
+    if (changed) {
+      for (unsigned i = 0; i < 256; i++) lut->entry[i] = ColorFromPalette(d.palette, i, 255, LINEARBLEND);
+      for (unsigned i = 0; i < words; i++) lut->source[i] = source[i];
+      lut->valid = 1;
+    }
+  }
+  #endif
 }
 
 // relies on WS2812FX::service() to call it for each frame
@@ -454,7 +802,7 @@ void Segment::handleRandomPalette() {
 
 // sets Segment geometry (length or width/height and grouping, spacing and offset as well as 2D mapping)
 // strip must be suspended (strip.suspend()) before calling this function
-// this function may call fill() to clear pixels if spacing or mapping changed (which requires setting _vWidth, _vHeight, _vLength or beginDraw())
+// this function may call fill() to clear pixels if spacing or mapping changed (which requires setDrawDimensions() or beginDraw())
 void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, uint16_t ofs, uint16_t i1Y, uint16_t i2Y, uint8_t m12) {
   // return if neither bounds nor grouping have changed
   bool boundsUnchanged = (start == i1 && stop == i2);
@@ -485,7 +833,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
 
   // apply change immediately
   if (i2 <= i1) { //disable segment
-    #ifdef WLED_ENABLE_GIF
+    #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
     endImagePlayback(this);
     #endif
     deallocateData();
@@ -506,7 +854,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   #endif
   // safety check
   if (start >= stop || startY >= stopY) {
-    #ifdef WLED_ENABLE_GIF
+    #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
     endImagePlayback(this);
     #endif
     deallocateData();
@@ -519,10 +867,10 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   if (length() != oldLength) {
     // allocate render buffer (always entire segment), prefer IRAM/PSRAM. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM) on S2/S3
     p_free(pixels);
-    pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+    pixels = static_cast<uint32_t*>(allocate_buffer(pixelBufferSize(length()), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
     if (!pixels) {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
-      #ifdef WLED_ENABLE_GIF
+      #if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
       endImagePlayback(this);
       #endif
       deallocateData();
@@ -530,7 +878,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
       stop = 0;
       return;
     }
-
+    invalidatePaletteLUT();
   }
   refreshLightCapabilities();
 }
@@ -1178,7 +1526,20 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
     case 1: blend = LINEARBLEND; break;
     case 2: blend = LINEARBLEND_NOWRAP; break;
   }
-  CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
+  #ifndef WLED_SAVE_RAM
+  if (const PaletteLUT *lut = paletteLUT()) {
+    // same result as ColorFromPalette(): NOWRAP remaps the index into the non-wrapping range, NOBLEND uses the palette entry (lo4 = 0)
+    if (blend == LINEARBLEND_NOWRAP) paletteIndex = (paletteIndex * 0xF0) >> 8;
+    else if (blend == NOBLEND)       paletteIndex &= 0xF0;
+    uint32_t palcol = lut->entry[paletteIndex & 0xFF];
+    if (pbri < 255) {
+      const uint32_t scale = pbri + 1;
+      palcol = (((palcol & 0x00FF00FF) * scale >> 8) & 0x00FF00FF) | (((palcol & 0x0000FF00) * scale >> 8) & 0x0000FF00);
+    }
+    return palcol | (color & 0xFF000000); // white channel from segment color
+  }
+  #endif
+  CRGBW palcol = ColorFromPalette(draw().palette, paletteIndex, pbri, blend);
   palcol.w = W(color);
 
   return palcol.color32;
@@ -1320,14 +1681,38 @@ void WS2812FX::service() {
   if (_triggered || _targetFps == FPS_UNLIMITED) timeToShow = true; // unlimited mode = no frametime; strip.trigger() can overrule timing
 
   now = nowUp + timebase;                               // common time base for all effects
+  #ifdef WLED_ENABLE_ASYNC_SHOW
+  flushShow();                                          // hand over deferred frame as soon as busses are free
+  if (_showPending) return;                             // deferred frame is the back buffer, do not render over it
+  #endif
   if (!timeToShow) return;                              // too early for service
   if (_suspend || elapsed <= MIN_FRAME_DELAY) return;   // keep wifi alive - no matter if triggered or unlimited
 
   _isServicing = true;
+  #ifdef WLED_SEGMENT_ARENA
+  Segment::compactData(); // close gaps left by effect data freed since last frame (no effect is running now)
+  #endif
+  #ifndef WLED_DISABLE_2D
+  Segment::tidyPolarMaps(); // start of frame, free maps of effects that are no longer running
+  #endif
+  #ifndef WLED_DISABLE_FX_PROFILE
+  if (_profile.size() != _segments.size() || nowUp - _profileStart >= WLED_FX_PROFILE_WINDOW) rollProfile(nowUp);
+  #endif
   bool doShow = _triggered;    // true if ≥1 active segment was processed (and strip was not suspended mid-loop), or trigger received → triggers show()
+  // measure how much of effect time overlaps with busses still sending previous frame (polled after each segment)
+  const unsigned long fxStart = micros();
+  unsigned long busyUntil = fxStart;
+  bool busBusy = !BusManager::canAllShow();
+  const auto pollBusses = [&]() { if (busBusy) { if (BusManager::canAllShow()) busBusy = false; else busyUntil = micros(); } };
+  #ifdef WLED_ENABLE_PARALLEL_FX
+  const uint64_t workerMask = startWorker(); // independent segments are drawn by render task on the other core
+  if (workerMask) doShow = true;
+  #endif
   for (size_t i = 0; i < _segments.size(); i++) {
+    #ifdef WLED_ENABLE_PARALLEL_FX
+    if (workerMask & (1ULL << i)) continue; // drawn by render task
+    #endif
     Segment &seg = _segments[i];
-    _segment_index = i;
     if (_suspend) break; // abort processing segments if suspend requested during service()
 
     // process transition (also pre-calculates progress value)
@@ -1340,31 +1725,19 @@ void WS2812FX::service() {
       // if we arrive here, its always showtime (timeToShow == true)
       doShow = true;
       if (!seg.freeze) { //only run effect function if not frozen
-        // Effect blending
-        uint16_t prog = seg.progress();
-        seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
-        _currentSegment = &seg;             // set current segment for effect functions (SEGMENT & SEGENV)
-        // workaround for on/off transition to respect blending style
-        _mode[seg.mode]();                  // run new/current mode (needed for bri workaround)
-        seg.call++;
-        // if segment is in transition and no old segment exists we don't need to run the old mode
-        // (blendSegments() takes care of On/Off transitions and clipping)
-        Segment *segO = seg.getOldSegment();
-        if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != TRANSITION_FADE ||
-            (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
-          Segment::modeBlend(true);         // set flag for beginDraw() to blend colors and palette
-          segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
-          _currentSegment = segO;           // set current segment
-          // workaround for on/off transition to respect blending style
-          _mode[segO->mode]();              // run old mode (needed for bri workaround; semaphore!!)
-          segO->call++;                     // increment old mode run counter
-          Segment::modeBlend(false);        // unset flag
-        }
+        renderSegment(seg, i);
+        pollBusses();
       }
     }
   }
-  _segment_index = 0;     // segment index is only valid while effects are serviced
-  _currentSegment = &_segments[0]; // safe fallback to prevent stale pointer - SEGMENT/SEGENV should not be used outside of the service loop
+  #ifdef WLED_ENABLE_PARALLEL_FX
+  waitForWorker(); // all segments must be drawn before blending
+  pollBusses();
+  #endif
+  _effectTime  = (7 * _effectTime  + (micros() - fxStart))   >> 3; // running average
+  _overlapTime = (7 * _overlapTime + (busyUntil - fxStart)) >> 3;
+  Segment::draw().segmentIndex = 0;           // segment index is only valid while effects are serviced
+  Segment::draw().segment = &_segments[0];    // safe fallback to prevent stale pointer - SEGMENT/SEGENV should not be used outside of the service loop
 
   #ifdef WLED_DEBUG
   if ((_targetFps != FPS_UNLIMITED) && (millis() - nowUp > _frametime)) DEBUG_PRINTF_P(PSTR("Slow effects %u/%d.\n"), (unsigned)(millis()-nowUp), (int)_frametime);
@@ -1383,62 +1756,283 @@ void WS2812FX::service() {
   _isServicing = false;
 }
 
+// runs effect function for segment (and old effect if segment is in transition) with draw context of calling task
+void WS2812FX::renderSegment(Segment &seg, uint8_t index) {
+  FxDrawContext &d = Segment::draw();
+  d.segmentIndex = index;
+  // Effect blending
+  uint16_t prog = seg.progress();
+  seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
+  d.segment = &seg;                   // set current segment for effect functions (SEGMENT & SEGENV)
+  d.prng.setSeed(seg._prngSeed);      // SEGPRNG sequence does not depend on other segments (or on the task drawing it)
+  #ifndef WLED_DISABLE_FX_PROFILE
+  FxProfile *profile = index < _profile.size() ? &_profile[index] : nullptr;
+  unsigned long t0 = micros();
+  #endif
+  // workaround for on/off transition to respect blending style
+  _mode[seg.mode]();                  // run new/current mode (needed for bri workaround)
+  seg.call++;
+  seg._prngSeed = d.prng.getSeed();
+  #ifndef WLED_DISABLE_FX_PROFILE
+  if (profile) {
+    profile->fx.add(micros() - t0);
+    profile->pixels = seg.rawLength();
+    profile->mode   = seg.mode;
+  }
+  #endif
+  // if segment is in transition and no old segment exists we don't need to run the old mode
+  // (blendSegments() takes care of On/Off transitions and clipping)
+  Segment *segO = seg.getOldSegment();
+  if (segO && segO->isActive() && (seg.mode != segO->mode || blendingStyle != TRANSITION_FADE ||
+      (segO->name != seg.name && segO->name && seg.name && strncmp(segO->name, seg.name, WLED_MAX_SEGNAME_LEN) != 0))) {
+    Segment::modeBlend(true);         // set flag for beginDraw() to blend colors and palette
+    segO->beginDraw(prog);            // set up palette & colors (also sets draw dimensions), parent segment has transition progress
+    d.segment = segO;                 // set current segment
+    d.prng.setSeed(segO->_prngSeed);
+    #ifndef WLED_DISABLE_FX_PROFILE
+    t0 = micros();
+    #endif
+    // workaround for on/off transition to respect blending style
+    _mode[segO->mode]();              // run old mode (needed for bri workaround; semaphore!!)
+    #ifndef WLED_DISABLE_FX_PROFILE
+    if (profile) profile->old.add(micros() - t0);
+    #endif
+    segO->call++;                     // increment old mode run counter
+    segO->_prngSeed = d.prng.getSeed();
+    Segment::modeBlend(false);        // unset flag
+  }
+}
+
+#ifndef WLED_DISABLE_FX_PROFILE
+// start new profile window (called from service() before any segment is drawn)
+void WS2812FX::rollProfile(unsigned long now) {
+  if (_profile.size() == _segments.size()) {
+    _profileLast   = _profile;
+    _profileWindow = now - _profileStart;
+  } else {
+    _profileLast.clear(); // segments were added or removed, indices no longer match
+    _profileWindow = 0;
+  }
+  _profile.resize(_segments.size());
+  for (FxProfile &p : _profile) p.reset();
+  _profileStart = now;
+}
+
+// per segment timing of the last completed window as [runs, min, avg, max] (us) for effect function,
+// old effect function (transition) and blendSegment(); segments that were neither drawn nor blended are omitted
+void WS2812FX::serializeProfile(JsonObject root) const {
+  JsonObject prof = root.createNestedObject(F("prof"));
+  prof[F("win")] = _profileWindow;
+  JsonArray segs = prof.createNestedArray(F("seg"));
+  const auto addTiming = [](JsonObject &obj, const __FlashStringHelper *key, const FxTiming &t) {
+    if (!t.runs) return;
+    JsonArray a = obj.createNestedArray(key);
+    a.add(t.runs);
+    a.add(t.minUs);
+    a.add(t.totalUs / t.runs);
+    a.add(t.maxUs);
+  };
+  for (size_t i = 0; i < _profileLast.size(); i++) {
+    const FxProfile &p = _profileLast[i];
+    if (!p.fx.runs && !p.blend.runs) continue;
+    JsonObject seg = segs.createNestedObject();
+    seg["id"] = i;
+    seg["fx"] = p.mode;
+    seg["px"] = p.pixels;  // virtual pixels drawn by effect
+    seg[F("len")] = i < _segments.size() ? _segments[i].length() : 0; // pixels blended
+    addTiming(seg, F("fxt"), p.fx);
+    addTiming(seg, F("oldt"), p.old);
+    addTiming(seg, F("blt"), p.blend);
+  }
+}
+#endif
+
+#ifdef WLED_ENABLE_PARALLEL_FX
+/*
+ * Parallel effect rendering
+ * Segment pixel buffers are independent, so effects of different segments can be drawn concurrently.
+ * startWorker() hands a subset of segments to a render task pinned to core 0 while loop() (core 1)
+ * draws the remaining ones; blending still happens in segment order in show() once both are done.
+ * Per-draw state (SEGMENT, SEGLEN, SEGCOLOR, SEGPALETTE, SEGPRNG, ...) lives in a FxDrawContext owned by each
+ * render task: loop() uses Segment::_mainDraw, the render task one on its stack (Segment::draw() points to it).
+ * SEGPRNG state is kept per segment, so output does not depend on which task draws a segment.
+ */
+void WS2812FX::fxWorkerTask(void *arg) {
+  WS2812FX *fx = static_cast<WS2812FX*>(arg);
+  FxDrawContext draw = FxDrawContext();
+  Segment::setDrawContext(&draw);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wait for startWorker()
+    for (size_t i = 0; i < fx->_segments.size(); i++) {
+      if (!(fx->_fxWorkerMask & (1ULL << i))) continue;
+      fx->renderSegment(fx->_segments[i], i);
+    }
+    draw.segmentIndex = 0;
+    draw.segment      = &fx->_segments[0];
+    xSemaphoreGive(fx->_fxWorkerDone);
+  }
+}
+
+// returns true if segment's effect does not depend on shared state and can be drawn by render task
+bool WS2812FX::canRenderOnWorker(const Segment &seg) const {
+  if (seg.isInTransition()) return false;    // old effect, clipping and blend flags are shared
+  if (seg.mode == FX_MODE_IMAGE) return false; // image decoder is not reentrant
+  um_data_t *um_data;
+  if (!UsermodManager::getUMData(&um_data, USERMOD_ID_AUDIOREACTIVE)) {
+    // simulated sound uses shared state, keep audio reactive effects ('v' or 'f' flag) on loop() task
+    const char *modeData = getModeData(seg.mode);
+    unsigned semicolons = 0;
+    for (size_t j = 0; j < 256; j++) {
+      char c = pgm_read_byte(modeData + j);
+      if (c == '\0') break;
+      if (c == ';') { if (++semicolons > 3) break; continue; }
+      if (semicolons == 3 && (c == 'v' || c == 'f')) return false;
+    }
+  }
+  return true;
+}
+
+// hands independent segments over to render task, returns mask of segments it will draw
+uint64_t WS2812FX::startWorker() {
+  _fxWorkerMask = 0;
+  if (_suspend || _segments.size() < 2) return 0;
+  // Copy effect reads pixel buffer of another segment which may be drawn at the same time
+  for (const Segment &seg : _segments) if (seg.isActive() && seg.mode == FX_MODE_COPY) return 0;
+
+  if (!_fxWorker) {
+    if (!_fxWorkerDone) _fxWorkerDone = xSemaphoreCreateBinary();
+    // loop() runs on core 1, same priority as loop() task
+    if (!_fxWorkerDone || !segmentDataMutex() || xTaskCreatePinnedToCore(fxWorkerTask, "FX_RENDER", 8192, this, 1, &_fxWorker, 0) != pdPASS) {
+      DEBUG_PRINTLN(F("FX render task not started."));
+      _fxWorker = nullptr;
+      return 0;
+    }
+  }
+
+  // balance pixel count: segments that must stay on loop() task count first, eligible ones go to the lighter side
+  unsigned mainLoad = 0, workerLoad = 0;
+  for (const Segment &seg : _segments) if (seg.isActive() && !seg.freeze && !canRenderOnWorker(seg)) mainLoad += seg.length();
+  for (size_t i = 0; i < _segments.size(); i++) {
+    Segment &seg = _segments[i];
+    if (!seg.isActive() || seg.freeze || !canRenderOnWorker(seg)) continue;
+    if (workerLoad > mainLoad) { mainLoad += seg.length(); continue; }
+    seg.resetIfRequired(); // may free effect data, must not run concurrently with effects
+    if (!seg.isActive()) continue;
+    workerLoad += seg.length();
+    _fxWorkerMask |= 1ULL << i;
+  }
+  if (_fxWorkerMask) xTaskNotifyGive(_fxWorker);
+  return _fxWorkerMask;
+}
+
+// blocks until render task has drawn all of its segments
+void WS2812FX::waitForWorker() {
+  if (_fxWorkerMask) xSemaphoreTake(_fxWorkerDone, portMAX_DELAY);
+  _fxWorkerMask = 0;
+}
+#endif
+
 // https://en.wikipedia.org/wiki/Blend_modes but using a for top layer & b for bottom layer
-static uint8_t _top       (uint8_t a, uint8_t b) { return a; } // function unused
-static uint8_t _bottom    (uint8_t a, uint8_t b) { return b; } // function unused
-static uint8_t _add       (uint8_t a, uint8_t b) { unsigned t = a + b; return t > 255 ? 255 : t; } // function unused
-static uint8_t _subtract  (uint8_t a, uint8_t b) { return b > a ? (b - a) : 0; }
-static uint8_t _difference(uint8_t a, uint8_t b) { return b > a ? (b - a) : (a - b); }
-static uint8_t _average   (uint8_t a, uint8_t b) { return (a + b) >> 1; }
 #if !defined(WLED_HAVE_FAST_int_DIVIDE)
-static uint8_t _multiply  (uint8_t a, uint8_t b) { return ((a * b) + 255) >> 8; } // faster than division on C3/C5 but slightly less accurate
+static inline uint8_t _multiply  (uint8_t a, uint8_t b) { return ((a * b) + 255) >> 8; } // faster than division on C3/C5 but slightly less accurate
 #else
-static uint8_t _multiply  (uint8_t a, uint8_t b) { return (a * b) / 255; } // origianl uses a & b in range [0,1]
+static inline uint8_t _multiply  (uint8_t a, uint8_t b) { return (a * b) / 255; } // origianl uses a & b in range [0,1]
 #endif
-static uint8_t _divide    (uint8_t a, uint8_t b) { return a > b ? (b * 255) / a : 255; }
-static uint8_t _lighten   (uint8_t a, uint8_t b) { return a > b ? a : b; }
-static uint8_t _darken    (uint8_t a, uint8_t b) { return a < b ? a : b; }
-static uint8_t _screen    (uint8_t a, uint8_t b) { return 255 - _multiply(~a,~b); } // 255 - (255-a)*(255-b)/255
-static uint8_t _overlay   (uint8_t a, uint8_t b) { return b < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
-static uint8_t _hardlight (uint8_t a, uint8_t b) { return a < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
+static inline uint8_t _divide    (uint8_t a, uint8_t b) { return a > b ? (b * 255) / a : 255; }
+static inline uint8_t _screen    (uint8_t a, uint8_t b) { return 255 - _multiply(~a,~b); } // 255 - (255-a)*(255-b)/255
+static inline uint8_t _overlay   (uint8_t a, uint8_t b) { return b < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
+static inline uint8_t _hardlight (uint8_t a, uint8_t b) { return a < 128 ? 2 * _multiply(a,b) : (255 - 2 * _multiply(~a,~b)); }
 #if !defined(WLED_HAVE_FAST_int_DIVIDE)
-static uint8_t _softlight (uint8_t a, uint8_t b) { return (((b * b * (255 - 2 * a))) + ((2 * a * b + 256) << 8)) >> 16; } // Pegtop's formula (1 - 2a)b^2
+static inline uint8_t _softlight (uint8_t a, uint8_t b) { return (((b * b * (255 - 2 * a))) + ((2 * a * b + 256) << 8)) >> 16; } // Pegtop's formula (1 - 2a)b^2
 #else
-static uint8_t _softlight (uint8_t a, uint8_t b) { return (b * b * (255 - 2 * a) + 255 * 2 * a * b) / (255 * 255); } // Pegtop's formula (1 - 2a)b^2 + 2ab
+static inline uint8_t _softlight (uint8_t a, uint8_t b) { return (b * b * (255 - 2 * a) + 255 * 2 * a * b) / (255 * 255); } // Pegtop's formula (1 - 2a)b^2 + 2ab
 #endif
-static uint8_t _dodge     (uint8_t a, uint8_t b) { return _divide(~a,b); }
-static uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
-static uint8_t _stencil   (uint8_t a, uint8_t b) { return a ? a : b; } // function unused
-static uint8_t _dummy     (uint8_t a, uint8_t b) { return a; } // dummy (same as _top) to fill the function list and make it safe from OOB access
+static inline uint8_t _dodge     (uint8_t a, uint8_t b) { return _divide(~a,b); }
+static inline uint8_t _burn      (uint8_t a, uint8_t b) { return ~_divide(a,~b); }
+
+// packed helpers for modes without multiplication: all 4 channels at once using 9 bit lanes (poorman's SIMD, see color_blend())
+// returns 0xFF in each channel where a >= b
+static inline uint32_t _packedGE(uint32_t a, uint32_t b) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t BORROW_MASK      = 0x01000100;
+  uint32_t rb = (((a & TWO_CHANNEL_MASK) | BORROW_MASK) - (b & TWO_CHANNEL_MASK)) & BORROW_MASK;
+  uint32_t wg = ((((a >> 8) & TWO_CHANNEL_MASK) | BORROW_MASK) - ((b >> 8) & TWO_CHANNEL_MASK)) & BORROW_MASK;
+  return (rb - (rb >> 8)) | ((wg - (wg >> 8)) << 8); // 0x100 -> 0x0FF
+}
+// returns b - a in each channel, clamped to 0
+static inline uint32_t _packedSub(uint32_t a, uint32_t b) {
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  const uint32_t BORROW_MASK      = 0x01000100;
+  uint32_t rb = ((b & TWO_CHANNEL_MASK) | BORROW_MASK) - (a & TWO_CHANNEL_MASK);
+  uint32_t wg = (((b >> 8) & TWO_CHANNEL_MASK) | BORROW_MASK) - ((a >> 8) & TWO_CHANNEL_MASK);
+  uint32_t mrb = rb & BORROW_MASK; mrb -= mrb >> 8; // 0x0FF if no borrow (b >= a)
+  uint32_t mwg = wg & BORROW_MASK; mwg -= mwg >> 8;
+  return (rb & mrb) | ((wg & mwg) << 8);
+}
+
+#define BLENDMODES  17 // number of blend modes must match "bm" in index.js, all cases must be handled in blendPixel()
+
+// blends top (t) and bottom (b) pixel using blend mode MODE (resolved at compile time, no per-channel function calls)
+template<unsigned MODE>
+static inline uint32_t blendPixel(uint32_t t, uint32_t b) {
+  #define BLEND_CHANNELS(f) RGBW32(f(R(t),R(b)), f(G(t),G(b)), f(B(t),B(b)), f(W(t),W(b)))
+  switch (MODE) {
+    default:
+    case 0 : return t;                                              // top
+    case 1 : return b;                                              // bottom
+    case 2 : return color_add(t,b,true);                            // add with preserve color ratio to avoid color clipping
+    case 3 : return _packedSub(t,b);                                // subtract (bottom - top)
+    case 4 : return _packedSub(t,b) | _packedSub(b,t);              // difference (one of them is always 0)
+    case 5 : return ((t >> 1) & 0x7F7F7F7F) + ((b >> 1) & 0x7F7F7F7F) + (t & b & 0x01010101); // average
+    case 6 : return BLEND_CHANNELS(_multiply);                      // multiply
+    case 7 : return BLEND_CHANNELS(_divide);                        // divide
+    case 8 : { uint32_t m = _packedGE(t,b); return (t & m) | (b & ~m); } // lighten
+    case 9 : { uint32_t m = _packedGE(t,b); return (b & m) | (t & ~m); } // darken
+    case 10: return BLEND_CHANNELS(_screen);                        // screen
+    case 11: return BLEND_CHANNELS(_overlay);                       // overlay
+    case 12: return BLEND_CHANNELS(_hardlight);                     // hard light
+    case 13: return BLEND_CHANNELS(_softlight);                     // soft light
+    case 14: return BLEND_CHANNELS(_dodge);                         // dodge
+    case 15: return BLEND_CHANNELS(_burn);                          // burn
+    case 16: return t ? t : b;                                      // stencil (use top layer if not black, else bottom)
+  }
+  #undef BLEND_CHANNELS
+}
+
+// blends a run of segment pixels (src) into frame buffer (dst), steps may be negative (reverse/transpose)
+// note: color_blend() returns bottom for opacity 0 and top for 255 so these are special-cased without changing results
+template<unsigned MODE>
+static void WLED_O2_ATTR blendRow(uint32_t *dst, int dstInc, const uint32_t *src, int srcInc, unsigned count, uint8_t opacity) {
+  if (MODE == 1 || opacity == 0) return; // bottom layer is kept
+  if (opacity == 255) {
+    if (MODE == 0 && dstInc == 1 && srcInc == 1) { memcpy(dst, src, count * sizeof(uint32_t)); return; }
+    for (unsigned i = 0; i < count; i++, dst += dstInc, src += srcInc) *dst = blendPixel<MODE>(*src, *dst);
+  } else {
+    for (unsigned i = 0; i < count; i++, dst += dstInc, src += srcInc) *dst = color_blend(*dst, blendPixel<MODE>(*src, *dst), opacity);
+  }
+}
 
-#define BLENDMODES  17 // number of blend modes must match "bm" in index.js, all cases must be handled in segblend() @ blendSegment()
+typedef uint32_t (*BlendPixelFunc)(uint32_t, uint32_t);
+typedef void (*BlendRowFunc)(uint32_t*, int, const uint32_t*, int, unsigned, uint8_t);
+static const BlendPixelFunc blendPixelFuncs[BLENDMODES] = {
+  blendPixel<0>,  blendPixel<1>,  blendPixel<2>,  blendPixel<3>,
+  blendPixel<4>,  blendPixel<5>,  blendPixel<6>,  blendPixel<7>,
+  blendPixel<8>,  blendPixel<9>,  blendPixel<10>, blendPixel<11>,
+  blendPixel<12>, blendPixel<13>, blendPixel<14>, blendPixel<15>,
+  blendPixel<16>
+};
+static const BlendRowFunc blendRowFuncs[BLENDMODES] = {
+  blendRow<0>,  blendRow<1>,  blendRow<2>,  blendRow<3>,
+  blendRow<4>,  blendRow<5>,  blendRow<6>,  blendRow<7>,
+  blendRow<8>,  blendRow<9>,  blendRow<10>, blendRow<11>,
+  blendRow<12>, blendRow<13>, blendRow<14>, blendRow<15>,
+  blendRow<16>
+};
 
 void WS2812FX::blendSegment(const Segment &topSegment) const {
-  typedef uint8_t(*FuncType)(uint8_t, uint8_t);
-  // function pointer array: fill with _dummy if using special case: avoid OOB access and always provide a valid path
-  // note: making the function array static const uses more ram and comes at no significant speed gain
-  FuncType funcs[] = {
-    _dummy,      _dummy,     _dummy,    _subtract,
-    _difference, _average,   _dummy,    _divide,
-    _lighten,    _darken,    _screen,   _overlay,
-    _hardlight,  _softlight, _dodge,    _burn,
-    _dummy
-  };
-
   const size_t blendMode = topSegment.blendMode < BLENDMODES ? topSegment.blendMode : 0; // default to top if unsupported mode
-  const auto segblend = [&](uint32_t t, uint32_t b){
-    // use direct calculations/returns for simple/frequent modes (faster)
-    switch (blendMode) {
-      case 0 : return t;                   // top
-      case 1 : return b;                   // bottom
-      case 2 : return color_add(t,b,true); // add with preserve color ratio to avoid color clipping
-      case 6 : return RGBW32(_multiply(R(t),R(b)), _multiply(G(t),G(b)), _multiply(B(t),B(b)), _multiply(W(t),W(b))); // multiply (7% faster than lambda at 100bytes flash cost)
-      case 16: return t ? t : b;           // stencil (use top layer if not black, else bottom)
-    }
-    // default: use function pointer from array
-    const auto func = funcs[blendMode];
-    return RGBW32(func(R(t),R(b)), func(G(t),G(b)), func(B(t),B(b)), func(W(t),W(b)));
-  };
+  const BlendPixelFunc segblend = blendPixelFuncs[blendMode]; // used for per-pixel paths (transitions, grouping, mirroring)
+  const BlendRowFunc   blendRun = blendRowFuncs[blendMode];   // used for fast paths
 
   const int     length     = topSegment.length();     // physical segment length (counts all pixels in 2D segment)
   const int     width      = topSegment.width();
@@ -1471,40 +2065,34 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         if (topSegment.reverse_y) { start_offset += (height - 1) * Segment::maxWidth; y_inc = -Segment::maxWidth; }
 
         for (int y = 0; y < height; y++) {
-          uint32_t* pRow = &_pixels[start_offset + y * y_inc];
-          const int y_width = y * width;
-          for (int x = 0; x < width; x++) {
-            uint32_t* p = pRow + x * x_inc;
-            uint32_t c_a = topSegment.getPixelColorRaw(x + y_width);
-            *p = color_blend(*p, segblend(c_a, *p), opacity);
-          }
+          blendRun(&_pixels[start_offset + y * y_inc], x_inc, &topSegment.pixels[y * width], 1, width, opacity);
         }
       } else { // transposed
+        // source pixel: swap x & y (height = virtual width), reverse if needed
+        const int srcInc = topSegment.reverse_y ? -height : height;
         for (int y = 0; y < height; y++) {
-          const int px = topSegment.reverse ? (height - y - 1) : y;  // source pixel: swap y into x, reverse if needed
-          for (int x = 0; x < width; x++) {
-            const int py = topSegment.reverse_y ? (width  - x - 1) : x;  // source pixel: swap x into y, reverse if needed
-            const uint32_t c_a = topSegment.getPixelColorRaw(px + py * height); // height = virtual width
-            const size_t idx = XY(topSegment.start + x, topSegment.startY + y); // write logical (non swapped) pixel coordinate
-            _pixels[idx] = color_blend(_pixels[idx], segblend(c_a, _pixels[idx]), opacity);
-          }
+          const int px = topSegment.reverse ? (height - y - 1) : y;
+          const uint32_t *src = &topSegment.pixels[px + (topSegment.reverse_y ? (width - 1) * height : 0)];
+          blendRun(&_pixels[XY(topSegment.start, topSegment.startY + y)], 1, src, srcInc, width, opacity); // write logical (non swapped) pixel coordinate
         }
       }
       return;
 #endif
     } else if (!isMatrix) {
       // 1D fast path, include CCT as it is more common on 1D setups
-      uint32_t* strip = _pixels;
-      int start = topSegment.start;
-      int off   = topSegment.offset;
-      for (int i = 0; i < length; i++) {
-        uint32_t c_a = topSegment.getPixelColorRaw(i);
-        int p = topSegment.reverse ? (length - i - 1) : i;
-        int idx = start + p + off;
-        if (idx >= topSegment.stop) idx -= length;
-        strip[idx] = color_blend(strip[idx], segblend(c_a, strip[idx]), opacity);
-        if (_pixelCCT) _pixelCCT[idx] = cct;
+      // offset rotates the segment: blend in two contiguous runs, split where the offset wraps around
+      uint32_t* strip = &_pixels[topSegment.start];
+      const uint32_t *src = topSegment.pixels;
+      const int off   = topSegment.offset % length; // guard: offset should already be < length (see deserializeSegment())
+      const int split = length - off;   // first pixel that wraps around
+      if (!topSegment.reverse) {
+        blendRun(strip + off, 1, src, 1, split, opacity);
+        blendRun(strip, 1, src + split, 1, off, opacity);
+      } else {
+        blendRun(strip + off - 1, -1, src, 1, off, opacity);
+        blendRun(strip + length - 1, -1, src + off, 1, split, opacity);
       }
+      if (_pixelCCT) memset(&_pixelCCT[topSegment.start], cct, length);
       return;
     }
   }
@@ -1740,6 +2328,15 @@ void WS2812FX::show() {
     return; // no pixels allocated, nothing to show
   }
 
+  #ifdef WLED_ENABLE_ASYNC_SHOW
+  // previous frame was not handed over yet (direct show() calls, i.e. realtime): painting over it would
+  // accumulate ABL color sums of both frames, wait for busses instead
+  while (_showPending) {
+    yield();
+    flushShow();
+  }
+  #endif
+
   unsigned long showNow = millis();
   size_t diff = showNow - _lastShow;
 
@@ -1751,19 +2348,108 @@ void WS2812FX::show() {
     _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
   if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
 
+  // avoid race condition, capture _callback value
+  show_callback callback = _callback;
+  bool doPaint = true; // false if frame buffer did not change since last bus update
+  _skippedSegments = 0;
+  _skippedPixels   = 0;
+
   if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
-    // clear frame buffer
-    memset(_pixels, 0, sizeof(uint32_t) * totalLen);
-    // blend all segments into (cleared) buffer
-    for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
-      blendSegment(seg);              // blend segment's buffer into frame buffer
+    // dirty tracking: segments whose pixels (and blend parameters) did not change since last show() keep their
+    // content in frame buffer; if nothing changed at all, busses already hold the frame and painting is skipped
+    // note: CCT buffer is not kept between frames so dirty segments need full re-blend; pixels drawn by an overlay
+    // (callback) in previous frame are only removed by full re-blend, an installed callback that draws nothing does not matter
+    const auto isVisible = [](const Segment &seg) { return seg.isActive() && (seg.on || seg.isInTransition()); };
+    const auto blend = [this](size_t i) {
+      #ifndef WLED_DISABLE_FX_PROFILE
+      unsigned long t0 = micros();
+      blendSegment(_segments[i]);
+      if (i < _profile.size()) _profile[i].blend.add(micros() - t0);
+      #else
+      blendSegment(_segments[i]);
+      #endif
+    };
+    bool fullBlend = _triggered || _pixelsWritten || isOffRefreshRequired() || (showNow - _lastBusShow >= STATIC_REFRESH_MS);
+    const uint32_t frameKey[] = {
+      uint32_t(_brightness) | (uint32_t(gammaCorrectCol) << 8) | (uint32_t(correctWB) << 9) | (uint32_t(cctFromRgb) << 10) | (uint32_t(isMatrix) << 11) | (uint32_t(realtimeRespectLedMaps) << 12) | (uint32_t(blendingStyle) << 16) | (uint32_t(realtimeMode) << 24),
+      uint32_t(totalLen) | (uint32_t(customMappingSize) << 16),
+      uint32_t(Segment::maxWidth) | (uint32_t(Segment::maxHeight) << 16),
+      uint32_t(uintptr_t(_pixels)),
+      uint32_t(uintptr_t(customMappingTable)),
+      uint32_t(BusManager::getNumBusses()) | (uint32_t(_segments.size()) << 8) | (uint32_t(uint16_t(Bus::getCCT())) << 16)
+    };
+    static_assert(sizeof(frameKey) == sizeof(_frameKey), "frame key size mismatch");
+    if (_forceFullBlend || memcmp(frameKey, _frameKey, sizeof(frameKey)) != 0) fullBlend = true; // mapping, brightness or segment count changed
+    memcpy(_frameKey, frameKey, sizeof(frameKey));
+    _forceFullBlend = false;
+    static_assert(MAX_NUM_SEGMENTS <= 64, "dirty segment mask too small");
+    uint64_t dirty = 0; // bit mask of segments that need re-blending
+    for (size_t i = 0; i < _segments.size(); i++) {
+      Segment &seg = _segments[i];
+      if (seg.updateBlendKey()) fullBlend = true; // segment layout or opacity changed (also covers order and inactive segments)
+      if (isVisible(seg) && (seg._dirty || seg.isInTransition())) dirty |= (1ULL << i);
+      seg._dirty = false;
+    }
+
+    // partial re-blend is only possible if no dirty segment overlaps another visible segment
+    bool partial = !fullBlend && (!_pixelCCT || !dirty);
+    for (size_t i = 0; partial && dirty && i < _segments.size(); i++) {
+      if (!(dirty & (1ULL << i))) continue;
+      uint16_t ax0, ax1, ay0, ay1, bx0, bx1, by0, by1;
+      if (!getBlendFootprint(_segments[i], ax0, ax1, ay0, ay1)) partial = false;
+      for (size_t j = 0; partial && j < _segments.size(); j++) {
+        if (j == i || !isVisible(_segments[j])) continue;
+        if (!getBlendFootprint(_segments[j], bx0, bx1, by0, by1) || (ax0 < bx1 && bx0 < ax1 && ay0 < by1 && by0 < ay1)) partial = false;
+      }
     }
+
+    if (partial) {
+      for (size_t i = 0; i < _segments.size(); i++) {
+        const Segment &seg = _segments[i];
+        if (!isVisible(seg)) continue;
+        if (dirty & (1ULL << i)) {
+          // clear segment's area in frame buffer and blend it again
+          uint16_t x0, x1, y0, y1;
+          getBlendFootprint(seg, x0, x1, y0, y1);
+          for (unsigned y = y0; y < y1; y++) memset(&_pixels[y * Segment::maxWidth + x0], 0, sizeof(uint32_t) * (x1 - x0));
+          blend(i);
+        } else {
+          _skippedSegments++;
+          _skippedPixels += seg.length();
+        }
+      }
+      doPaint = dirty != 0;
+    } else {
+      // clear frame buffer
+      memset(_pixels, 0, sizeof(uint32_t) * totalLen);
+      // blend all segments into (cleared) buffer
+      for (size_t i = 0; i < _segments.size(); i++) if (isVisible(_segments[i])) {
+        blend(i);                       // blend segment's buffer into frame buffer
+      }
+    }
+  } else {
+    _forceFullBlend = true; // frame buffer is written directly (realtime), force full re-blend afterwards
   }
 
-  // avoid race condition, capture _callback value
-  show_callback callback = _callback;
+  _pixelsWritten = false;
   if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
+  if (_pixelsWritten) doPaint = true; // overlay drew into frame buffer
 
+  if (doPaint) paintPixels(totalLen);
+  else {
+    p_free(_pixelCCT);
+    _pixelCCT = nullptr;
+  }
+
+  if (diff > 0) { // skip calculation if no time has passed
+    size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
+    _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
+    _lastShow = showNow;
+  }
+}
+
+// send frame buffer to busses (applies gamma correction, CCT and ledmap)
+void WS2812FX::paintPixels(size_t totalLen) {
   // paint actual pixels
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
   // when cctFromRgb is true we implicitly calculate WW and CW from RGB values (cct==-1)
@@ -1771,17 +2457,40 @@ void WS2812FX::show() {
   // use color gamma correction if enabled, not in realtime mode with gamma disabled or currently overriding RT mode
   bool useGammaCorrection = gammaCorrectCol && !(realtimeMode && arlsDisableGammaCorrection && !realtimeOverride);
 
-  for (size_t i = 0; i < totalLen; i++) {
-    // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
-    // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
-    if (_pixelCCT) { // cctFromRgb already exluded at allocation
-      if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
-    }
+  const bool useMapping = customMappingSize > 0 && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps);
+
+  if (!useGammaCorrection && !useMapping && !_pixelCCT) {
+    BusManager::setPixels(0, _pixels, totalLen); // frame buffer can be passed as is
+  } else {
+    // pixels are passed to busses in spans of consecutive physical pixels (after ledmap is applied)
+    // a span ends if mapping is not contiguous, CCT changes or span buffer is full
+    constexpr size_t SPAN_SIZE = 64;
+    uint32_t span[SPAN_SIZE];
+    size_t   spanStart = 0;
+    size_t   spanLen   = 0;
+    for (size_t i = 0; i < totalLen; i++) {
+      // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
+      // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
+      if (_pixelCCT) { // cctFromRgb already exluded at allocation
+        if (i == 0 || _pixelCCT[i-1] != _pixelCCT[i]) {
+          if (spanLen) BusManager::setPixels(spanStart, span, spanLen); // flush span with previous CCT
+          spanLen = 0;
+          BusManager::setSegmentCCT(_pixelCCT[i], correctWB);
+        }
+      }
 
-    uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
-    if (c > 0 && useGammaCorrection)
-      c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
-    BusManager::setPixelColor(getMappedPixelIndex(i), c);
+      uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
+      if (c > 0 && useGammaCorrection)
+        c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
+      const size_t idx = getMappedPixelIndex(i);
+      if (spanLen && (idx != spanStart + spanLen || spanLen == SPAN_SIZE)) {
+        BusManager::setPixels(spanStart, span, spanLen);
+        spanLen = 0;
+      }
+      if (spanLen == 0) spanStart = idx;
+      span[spanLen++] = c;
+    }
+    if (spanLen) BusManager::setPixels(spanStart, span, spanLen);
   }
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
 
@@ -1791,13 +2500,39 @@ void WS2812FX::show() {
   // some buses send asynchronously and this method will return before
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
+  #ifdef WLED_ENABLE_ASYNC_SHOW
+  // NeoPixelBus keeps separate editing and sending buffers (swapped on show) so the new frame is already in place;
+  // if busses are still sending previous frame, hand-off is deferred to flushShow() instead of waiting in NeoPixelBus
+  _showPending = true;
+  flushShow();
+  #else
   BusManager::show();
+  _lastBusShow = millis();
+  #endif
+}
 
-  if (diff > 0) { // skip calculation if no time has passed
-    size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
-    _cumulativeFps = (FPS_CALC_AVG * _cumulativeFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);   // "+FPS_CALC_AVG/2" for proper rounding
-    _lastShow = showNow;
+#ifdef WLED_ENABLE_ASYNC_SHOW
+void WS2812FX::flushShow() {
+  if (!_showPending || !BusManager::canAllShow()) return;
+  _showPending = false;
+  BusManager::show();
+  _lastBusShow = millis();
+}
+#endif
+
+// returns frame buffer area blendSegment() writes to (in matrix coordinates, 1D uses single row)
+// returns false if segment is not blended as a rectangle (1D segment extending beyond matrix)
+bool WS2812FX::getBlendFootprint(const Segment &seg, uint16_t &x0, uint16_t &x1, uint16_t &y0, uint16_t &y1) const {
+  x0 = seg.start;
+  x1 = seg.stop;
+  y0 = 0;
+  y1 = 1;
+  if (isMatrix) {
+    if (size_t(seg.start + seg.startY * Segment::maxWidth) + seg.length() > size_t(Segment::maxWidth) * Segment::maxHeight) return false; // see blendSegment()
+    y0 = seg.startY;
+    y1 = seg.stopY;
   }
+  return x1 > x0;
 }
 
 void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
@@ -1809,6 +2544,33 @@ void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   }
 }
 
+// writes count pixels of raw RGB (channels = 3) or RGBW (channels = 4) data directly into frame buffer
+// (or main segment's buffer), pixels outside of buffer are dropped
+void WS2812FX::setRealtimePixels(int start, const uint8_t *data, size_t count, unsigned channels) {
+  uint32_t *dst = _pixels;
+  int len = getLengthTotal();
+  if (useMainSegmentOnly) {
+    const Segment &seg = getMainSegment();
+    if (!seg.isActive()) return;
+    dst = seg.pixels;
+    len = seg.length();
+    seg.markDirty();
+  }
+  if (!dst || start >= len || start + int(count) <= 0) return;
+  if (start < 0) {
+    data  += size_t(-start) * channels;
+    count -= -start;
+    start  = 0;
+  }
+  if (count > size_t(len - start)) count = len - start;
+  dst += start;
+  if (channels == 4) {
+    for (size_t i = 0; i < count; i++, data += 4) dst[i] = RGBW32(data[0], data[1], data[2], data[3]);
+  } else {
+    for (size_t i = 0; i < count; i++, data += 3) dst[i] = RGBW32(data[0], data[1], data[2], 0);
+  }
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
@@ -2111,8 +2873,64 @@ void WS2812FX::printSize() {
 }
 #endif
 
+// compiled ledmap: ledmapN.lmb is generated next to ledmapN.json on first load and read in bulk afterwards
+#define LEDMAP_BIN_MAGIC    0x4D4C5757 // "WLLM"
+#define LEDMAP_BIN_VERSION  1
+#define LEDMAP_BIN_COMPLETE 0x01       // whole JSON map is contained (not truncated to LED count at compile time)
+
+struct LedmapBinHeader {
+  uint32_t magic;
+  uint8_t  version;
+  uint8_t  flags;
+  uint16_t reserved;
+  uint16_t width;     // 0 if not specified in JSON
+  uint16_t height;    // 0 if not specified in JSON
+  uint32_t count;     // number of uint16_t indices following the header
+  uint32_t jsonSize;  // size of source JSON (stale file detection)
+  uint32_t checksum;  // FNV-1a over indices
+};
+
+static uint32_t ledmapChecksum(uint32_t hash, const uint16_t *map, size_t count) {
+  const uint8_t *b = reinterpret_cast<const uint8_t*>(map);
+  for (size_t i = 0; i < count * sizeof(uint16_t); i++) hash = (hash ^ b[i]) * 16777619U;
+  return hash;
+}
+
+// bulk read indices from compiled ledmap (file position after header), returns false on checksum mismatch
+bool WS2812FX::readCompiledMap(File &f, const LedmapBinHeader &hdr) {
+  size_t count = min((size_t)hdr.count, (size_t)getLengthTotal());
+  if (f.read(reinterpret_cast<uint8_t*>(customMappingTable), count * sizeof(uint16_t)) != count * sizeof(uint16_t)) return false;
+  uint32_t hash = ledmapChecksum(2166136261U, customMappingTable, count);
+  uint16_t tail[32]; // map may have been compiled for more LEDs, verify the remainder too
+  for (size_t i = count; i < hdr.count; ) {
+    size_t chunk = min((size_t)(hdr.count - i), sizeof(tail)/sizeof(uint16_t));
+    if (f.read(reinterpret_cast<uint8_t*>(tail), chunk * sizeof(uint16_t)) != chunk * sizeof(uint16_t)) return false;
+    hash = ledmapChecksum(hash, tail, chunk);
+    i += chunk;
+  }
+  if (hash != hdr.checksum) return false;
+  customMappingSize = count;
+  return true;
+}
+
+// write customMappingTable to compiled ledmap, failure is not fatal (JSON will be parsed again on next load)
+void WS2812FX::writeCompiledMap(const char *fileName, size_t jsonSize, uint16_t width, uint16_t height, bool complete) {
+  LedmapBinHeader hdr = {LEDMAP_BIN_MAGIC, LEDMAP_BIN_VERSION, uint8_t(complete ? LEDMAP_BIN_COMPLETE : 0), 0, width, height,
+                         customMappingSize, (uint32_t)jsonSize, ledmapChecksum(2166136261U, customMappingTable, customMappingSize)};
+  File f = WLED_FS.open(fileName, "w");
+  if (!f) return;
+  size_t len = customMappingSize * sizeof(uint16_t);
+  bool ok = f.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)
+         && f.write(reinterpret_cast<const uint8_t*>(customMappingTable), len) == len;
+  f.close();
+  if (!ok) WLED_FS.remove(fileName); // FS full, do not leave a truncated file behind
+  DEBUG_PRINTF_P(PSTR("Compiled ledmap %s: %s\n"), fileName, ok ? "ok" : "failed");
+  updateFSInfo();
+}
+
 // load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
 // if this is a matrix set-up and default ledmap.json file does not exist, create mapping table using setUpMatrix() from panel information
+// JSON is only parsed once, afterwards compiled ledmapN.lmb (header + raw uint16_t indices) is used unless JSON changed
 // WARNING: effect drawing has to be suspended (strip.suspend()) or must be called from loop() context
 bool WS2812FX::deserializeMap(unsigned n) {
   char fileName[32];
@@ -2134,78 +2952,130 @@ bool WS2812FX::deserializeMap(unsigned n) {
     return false;
   }
 
-  if (!isFile || !requestJSONBufferLock(JSON_LOCK_LEDMAP)) return false;
-
-  StaticJsonDocument<64> filter;
-  filter[F("width")]  = true;
-  filter[F("height")] = true;
-  if (!readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
-    DEBUG_PRINTF_P(PSTR("ERROR Invalid ledmap in %s\n"), fileName);
-    releaseJSONBufferLock();
-    return false; // if file does not load properly then exit
-  } else
-    DEBUG_PRINTF_P(PSTR("Reading LED map from %s\n"), fileName);
-
-  JsonObject root = pDoc->as<JsonObject>();
-  // if we are loading default ledmap (at boot) set matrix width and height from the ledmap (compatible with WLED MM ledmaps)
-  if (n == 0 && (!root[F("width")].isNull() || !root[F("height")].isNull())) {
-    Segment::maxWidth  = min(max(root[F("width")].as<int>(), 1), 255);
-    Segment::maxHeight = min(max(root[F("height")].as<int>(), 1), 255);
-    isMatrix = true;
-    DEBUG_PRINTF_P(PSTR("LED map width=%d, height=%d\n"), Segment::maxWidth, Segment::maxHeight);
-  }
-
-  d_free(customMappingTable);
-  customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
-
-  if (customMappingTable) {
-    DEBUG_PRINTF_P(PSTR("ledmap allocated: %uB\n"), sizeof(uint16_t)*getLengthTotal());
-    File f = WLED_FS.open(fileName, "r");
-    f.find("\"map\":[");
-    while (f.available()) { // f.position() < f.size() - 1
-      char number[32];
-      size_t numRead = f.readBytesUntil(',', number, sizeof(number)-1); // read a single number (may include array terminating "]" but not number separator ',')
-      number[numRead] = 0;
-      if (numRead > 0) {
-        char *end = strchr(number,']'); // we encountered end of array so stop processing if no digit found
-        bool foundDigit = (end == nullptr);
-        int i = 0;
-        if (end != nullptr) do {
-          if (number[i] >= '0' && number[i] <= '9') foundDigit = true;
-          if (foundDigit || &number[i++] == end) break;
-        } while (i < 32);
-        if (!foundDigit) break;
-        int index = atoi(number);
-        if (index < 0 || index > 65535) index = 0xFFFF; // prevent integer wrap around
-        customMappingTable[customMappingSize++] = index;
-        if (end != nullptr) break; // array closing ']' was in this chunk; stop before atoi() coerces trailing JSON keys into bogus entries
-        if (customMappingSize >= getLengthTotal()) break;
-      } else break; // there was nothing to read, stop
+  if (!isFile) return false;
+
+  // load statistics (reported in JSON info)
+  const unsigned long loadStart = millis();
+  const size_t heapStart = getFreeHeapSize();
+  size_t heapLow = heapStart;
+  const auto sampleHeap = [&]() { size_t heap = getFreeHeapSize(); if (heap < heapLow) heapLow = heap; };
+
+  char binName[32];
+  strcpy(binName, fileName);
+  strcpy_P(binName + strlen(binName) - 5, PSTR(".lmb")); // ledmapN.json -> ledmapN.lmb
+  File f = WLED_FS.open(fileName, "r");
+  size_t jsonSize = f.size();
+  f.close();
+
+  // try compiled ledmap first
+  bool compiled = false;
+  f = WLED_FS.open(binName, "r");
+  if (f) {
+    sampleHeap();
+    LedmapBinHeader hdr;
+    compiled = f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)
+            && hdr.magic == LEDMAP_BIN_MAGIC && hdr.version == LEDMAP_BIN_VERSION && hdr.jsonSize == jsonSize
+            && f.size() == sizeof(hdr) + hdr.count * sizeof(uint16_t);
+    if (compiled && n == 0 && (hdr.width || hdr.height)) {
+      Segment::maxWidth  = min(max((int)hdr.width, 1), 255);
+      Segment::maxHeight = min(max((int)hdr.height, 1), 255);
+      isMatrix = true;
+      DEBUG_PRINTF_P(PSTR("LED map width=%d, height=%d\n"), Segment::maxWidth, Segment::maxHeight);
+    }
+    if (compiled && !(hdr.flags & LEDMAP_BIN_COMPLETE) && hdr.count < getLengthTotal()) compiled = false; // compiled for fewer LEDs
+    if (compiled) {
+      d_free(customMappingTable);
+      customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
+      sampleHeap();
+      compiled = customMappingTable && readCompiledMap(f, hdr);
     }
-    currentLedmap = n;
     f.close();
+    if (compiled) {
+      currentLedmap = n;
+      DEBUG_PRINTF_P(PSTR("Read compiled LED map from %s\n"), binName);
+    } else {
+      customMappingSize = 0;
+      DEBUG_PRINTF_P(PSTR("Stale or invalid compiled ledmap %s\n"), binName);
+    }
+  }
 
-    #ifdef WLED_DEBUG
-    DEBUG_PRINT(F("Loaded ledmap:"));
-    for (unsigned i=0; i<customMappingSize; i++) {
-      if (!(i%Segment::maxWidth)) DEBUG_PRINTLN();
-      DEBUG_PRINTF_P(PSTR("%4d,"), customMappingTable[i] < 0xFFFFU ? customMappingTable[i] : -1);
+  if (!compiled) {
+    if (!requestJSONBufferLock(JSON_LOCK_LEDMAP)) return false;
+
+    StaticJsonDocument<64> filter;
+    filter[F("width")]  = true;
+    filter[F("height")] = true;
+    if (!readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
+      DEBUG_PRINTF_P(PSTR("ERROR Invalid ledmap in %s\n"), fileName);
+      releaseJSONBufferLock();
+      return false; // if file does not load properly then exit
+    } else
+      DEBUG_PRINTF_P(PSTR("Reading LED map from %s\n"), fileName);
+
+    JsonObject root = pDoc->as<JsonObject>();
+    uint16_t width  = root[F("width")]  | 0;
+    uint16_t height = root[F("height")] | 0;
+    // if we are loading default ledmap (at boot) set matrix width and height from the ledmap (compatible with WLED MM ledmaps)
+    if (n == 0 && (!root[F("width")].isNull() || !root[F("height")].isNull())) {
+      Segment::maxWidth  = min(max(root[F("width")].as<int>(), 1), 255);
+      Segment::maxHeight = min(max(root[F("height")].as<int>(), 1), 255);
+      isMatrix = true;
+      DEBUG_PRINTF_P(PSTR("LED map width=%d, height=%d\n"), Segment::maxWidth, Segment::maxHeight);
     }
-    DEBUG_PRINTLN();
-    #endif
-/*
-    JsonArray map = root[F("map")];
-    if (!map.isNull() && map.size()) {  // not an empty map
-      customMappingSize = min((unsigned)map.size(), (unsigned)getLengthTotal());
-      for (unsigned i=0; i<customMappingSize; i++) customMappingTable[i] = (uint16_t) (map[i]<0 ? 0xFFFFU : map[i]);
+
+    d_free(customMappingTable);
+    customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
+    sampleHeap();
+
+    if (customMappingTable) {
+      DEBUG_PRINTF_P(PSTR("ledmap allocated: %uB\n"), sizeof(uint16_t)*getLengthTotal());
+      bool complete = true; // false if map was truncated to LED count
+      f = WLED_FS.open(fileName, "r");
+      sampleHeap();
+      f.find("\"map\":[");
+      while (f.available()) { // f.position() < f.size() - 1
+        char number[32];
+        size_t numRead = f.readBytesUntil(',', number, sizeof(number)-1); // read a single number (may include array terminating "]" but not number separator ',')
+        number[numRead] = 0;
+        if (numRead > 0) {
+          char *end = strchr(number,']'); // we encountered end of array so stop processing if no digit found
+          bool foundDigit = (end == nullptr);
+          int i = 0;
+          if (end != nullptr) do {
+            if (number[i] >= '0' && number[i] <= '9') foundDigit = true;
+            if (foundDigit || &number[i++] == end) break;
+          } while (i < 32);
+          if (!foundDigit) break;
+          int index = atoi(number);
+          if (index < 0 || index > 65535) index = 0xFFFF; // prevent integer wrap around
+          customMappingTable[customMappingSize++] = index;
+          if (end != nullptr) break; // array closing ']' was in this chunk; stop before atoi() coerces trailing JSON keys into bogus entries
+          if (customMappingSize >= getLengthTotal()) { complete = false; break; }
+        } else break; // there was nothing to read, stop
+      }
       currentLedmap = n;
+      f.close();
+      if (customMappingSize) writeCompiledMap(binName, jsonSize, width, height, complete);
+    } else {
+      DEBUG_PRINTLN(F("ERROR LED map allocation error."));
     }
-*/
-  } else {
-    DEBUG_PRINTLN(F("ERROR LED map allocation error."));
+
+    releaseJSONBufferLock();
+  }
+
+  #ifdef WLED_DEBUG
+  DEBUG_PRINT(F("Loaded ledmap:"));
+  for (unsigned i=0; i<customMappingSize; i++) {
+    if (!(i%Segment::maxWidth)) DEBUG_PRINTLN();
+    DEBUG_PRINTF_P(PSTR("%4d,"), customMappingTable[i] < 0xFFFFU ? customMappingTable[i] : -1);
   }
+  DEBUG_PRINTLN();
+  #endif
+
+  _ledmapLoadTime = min(millis() - loadStart, 65535UL);
+  _ledmapLoadHeap = heapStart - heapLow;
+  DEBUG_PRINTF_P(PSTR("Ledmap %u loaded in %ums, peak heap %uB\n"), n, (unsigned)_ledmapLoadTime, (unsigned)_ledmapLoadHeap);
 
-  releaseJSONBufferLock();
   if (strip.getLengthTotal() != lengthTotalBefore)
     strip.updatePixelBuffer(); // allocate _pixels[] to match new length
   return (customMappingSize > 0);
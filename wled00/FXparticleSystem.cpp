@@ -37,7 +37,6 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   motionBlur = 0; //no fading by default
   smearBlur = 0; //no smearing by default
   emitIndex = 0;
-  collisionStartIdx = 0;
 
   //initialize some default non-zero values most FX use
   for (uint32_t i = 0; i < numParticles; i++) {
@@ -54,9 +53,14 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
 
 // update function applies gravity, moves the particles, handles collisions and renders the particles
 void ParticleSystem2D::update(void) {
-  //apply gravity globally if enabled
-  if (particlesettings.useGravity)
-    applyGravity();
+  //apply gravity globally if enabled: collisions need the new speed, otherwise it is applied in the move loop (one pass over all particles)
+  int32_t gravitydv = 0;
+  if (particlesettings.useGravity) {
+    if (particlesettings.useCollisions)
+      applyGravity();
+    else
+      gravitydv = calcForce_dv(gforce, gforcecounter);
+  }
 
   //update size settings before handling collisions
   if (advPartSize != nullptr) {
@@ -72,9 +76,7 @@ void ParticleSystem2D::update(void) {
     handleCollisions();
 
   //move all particles
-  for (uint32_t i = 0; i < usedParticles; i++) {
-    particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr); // note: splitting this into two loops is slower and uses more flash
-  }
+  moveParticles(gravitydv);
 
   render();
 }
@@ -284,6 +286,48 @@ void ParticleSystem2D::particleMoveUpdate(PSparticle &part, PSparticleFlags &par
   }
 }
 
+// move all particles using PS settings: particles that stay clear of the borders are aged and moved in a tight loop,
+// all others (and per-particle sizes, which change the hard radius) go through particleMoveUpdate() for bounce/wrap/kill handling
+// gravitydv is the gravity speed change of this frame (same as applyGravity(), 0 if already applied or disabled)
+void WLED_O2_ATTR ParticleSystem2D::moveParticles(const int32_t gravitydv) {
+  if (perParticleSize && advPartProps != nullptr) {
+    for (uint32_t i = 0; i < usedParticles; i++) {
+      if (gravitydv) particles[i].vy = limitSpeed((int32_t)particles[i].vy - gravitydv);
+      particleMoveUpdate(particles[i], particleFlags[i], nullptr, &advPartProps[i]);
+    }
+    return;
+  }
+  // inside [lo, hi] no bounce, wrap or out of bounds check can trigger (hard radius is the bounce margin, render radius only matters outside the frame)
+  const int32_t lo = particleHardRadius;
+  if (maxX < 2 * lo || maxY < 2 * lo) { // tiny matrix, everything is near a border
+    for (uint32_t i = 0; i < usedParticles; i++) {
+      if (gravitydv) particles[i].vy = limitSpeed((int32_t)particles[i].vy - gravitydv);
+      particleMoveUpdate(particles[i], particleFlags[i]);
+    }
+    return;
+  }
+  const uint32_t spanX = maxX - 2 * lo; // unsigned compare: (new - lo) > span is true below lo and above (max - lo)
+  const uint32_t spanY = maxY - 2 * lo;
+  const bool colorByAge = particlesettings.colorByAge;
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    PSparticle &part = particles[i];
+    if (gravitydv) part.vy = limitSpeed((int32_t)part.vy - gravitydv); // note: dead particles too, same as applyGravity()
+    if (part.ttl == 0) continue;
+    int32_t newX = part.x + (int32_t)part.vx;
+    int32_t newY = part.y + (int32_t)part.vy;
+    if ((uint32_t)(newX - lo) > spanX || (uint32_t)(newY - lo) > spanY) { // near or beyond a border
+      particleMoveUpdate(part, particleFlags[i]);
+      continue;
+    }
+    part.ttl -= !particleFlags[i].perpetual; // age
+    if (colorByAge)
+      part.hue = min(part.ttl, (uint16_t)255); //set color to ttl
+    particleFlags[i].outofbounds = false;
+    part.x = (int16_t)newX;
+    part.y = (int16_t)newY;
+  }
+}
+
 // move function for fire particles
 void ParticleSystem2D::fireParticleupdate() {
   for (uint32_t i = 0; i < usedParticles; i++) {
@@ -441,14 +485,17 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
+  // for small forces, need to use a delay counter (shared by all particles, so velocity change is the same for all)
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  int32_t dvx = calcForce_dv(xforce, xcounter);
+  int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save counter values back
+  if (dvx == 0 && dvy == 0) return;
   for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -514,6 +561,7 @@ void ParticleSystem2D::applyFriction(PSparticle &part, const int32_t coefficient
 // apply friction to all particles
 // note: not checking if particle is dead is faster as most are usually alive and if few are alive, rendering is fast anyways
 void ParticleSystem2D::applyFriction(const int32_t coefficient) {
+  if (coefficient == 0) return; // no change in speed
   #if !defined(WLED_HAVE_FAST_int_DIVIDE) // use bitshifts with rounding instead of division (2x faster)
   int32_t friction = 256 - coefficient;
   for (uint32_t i = 0; i < usedParticles; i++) {
@@ -567,6 +615,7 @@ void ParticleSystem2D::render() {
     PSPRINTLN(F("PS render: no framebuffer!"));
     return;
   }
+  SEGMENT.markDirty(); // framebuffer is written directly
   CRGBW baseRGB;
   uint32_t brightness; // particle brightness, fades if dying
   TBlendType blend = LINEARBLEND; // default color rendering: wrap palette
@@ -812,82 +861,125 @@ void WLED_O2_ATTR ParticleSystem2D::renderLargeParticle(const uint32_t size, con
 }
 
 // detect collisions in an array of particles and handle them
-// uses binning by dividing the frame into slices in x direction which is efficient if using gravity in y direction (but less efficient for FX that use forces in x direction)
-// for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
-// note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
+// uses a uniform grid (cell size >= collision distance) built by a counting sort of the particle indices, so every particle only
+// checks the particles in its own and the neighbouring cells. all particles are checked every frame, no matter how densely packed
+// note: grid is built from lookahead positions (x + vx), which is what the distance check uses, so no pairs in range are missed
+#ifdef PIO_UNIT_TESTING
+PSCollisionTestHook psCollisionTestHook = {nullptr, nullptr};
+#endif
+
 void ParticleSystem2D::handleCollisions() {
-  uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
-  collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
-  // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
-  // if they are, collisionStartIdx is increased so each particle collides at least every second frame (which still gives decent collisions)
-  int binWidth = 6 * PS_P_RADIUS; // width of a bin in sub-pixels
-  int32_t overlap = particleHardRadius << 1; // overlap bins to include edge particles to neighbouring bins
-  if (perParticleSize && advPartProps != nullptr)
-    overlap = 512; // max overlap for collision detection if using per-particle size, enough to catch all particles even at max speed
+  const bool useSize = perParticleSize && advPartProps != nullptr;
+  uint32_t collDist = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  uint32_t collDistSq = collDist * collDist; // square it for faster comparison (square is one operation)
+  if (useSize) { // cell size must fit the largest collision distance
+    uint32_t maxSize = 0;
+    for (uint32_t i = 0; i < usedParticles; i++)
+      if (advPartProps[i].size > maxSize) maxSize = advPartProps[i].size;
+    collDist = (PS_P_MINHARDRADIUS << 1) + ((maxSize * 2 * 52) >> 6); // see per particle collision distance below
+  }
+
+  // grid size: smallest power of 2 cell that fits the collision distance, coarser if there are more cells than particles (limits scratch memory)
+  const uint32_t maxCells = max(usedParticles, (uint32_t)64);
+  uint32_t cellShift = PS_P_RADIUS_SHIFT;
+  while ((1U << cellShift) < collDist) cellShift++;
+  uint32_t gridW = (maxX >> cellShift) + 1;
+  uint32_t gridH = (maxY >> cellShift) + 1;
+  while (gridW * gridH > maxCells) {
+    cellShift++;
+    gridW = (maxX >> cellShift) + 1;
+    gridH = (maxY >> cellShift) + 1;
+  }
+  const uint32_t numCells = gridW * gridH;
+  #ifdef PIO_UNIT_TESTING
+  if (psCollisionTestHook.begin) psCollisionTestHook.begin(*this, collDist);
+  #endif
 
-  uint32_t maxBinParticles = max((uint32_t)50, (usedParticles + 1) / 2); // assume no more than half of the particles are in the same bin, do not bin small amounts of particles
-  uint32_t numBins = (maxX + (binWidth - 1)) / binWidth; // number of bins in x direction
-  if (usedParticles < maxBinParticles) {
-    numBins = 1; // use single bin for small number of particles
-    binWidth = maxX + 1;
+  // grid memory is part of the PS data (see collisionGridEntries()): cell start indices + sorted particle indices
+  uint16_t *cellStart = collisionGrid;            // particles of cell c are sorted[cellStart[c]] ... sorted[cellStart[c+1] - 1]
+  uint16_t *sorted = collisionGrid + numCells + 1;
+
+  // cell of a particle (lookahead position, clamped to grid: particles outside the frame are merged into edge cells)
+  auto cellOf = [&](const PSparticle &p) -> uint32_t {
+    int32_t px = p.x + p.vx;
+    int32_t py = p.y + p.vy;
+    uint32_t cx = px < 0 ? 0 : min((uint32_t)px >> cellShift, gridW - 1);
+    uint32_t cy = py < 0 ? 0 : min((uint32_t)py >> cellShift, gridH - 1);
+    return cy * gridW + cx;
+  };
+  auto collides = [&](uint32_t i) {
+    return particles[i].ttl > 0 && particleFlags[i].outofbounds == 0 && particleFlags[i].collide;
+  };
+
+  // counting sort: count particles per cell, prefix sum, scatter indices
+  memset(cellStart, 0, (numCells + 1) * sizeof(uint16_t));
+  for (uint32_t i = 0; i < usedParticles; i++)
+    if (collides(i)) cellStart[cellOf(particles[i]) + 1]++;
+  for (uint32_t c = 0; c < numCells; c++)
+    cellStart[c + 1] += cellStart[c];
+  // scatter starting at a random particle so collision order (and thus pushing direction) is not biased, cellStart[c] ends up as end of cell c
+  uint32_t pidx = hw_random16(usedParticles);
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (collides(pidx)) sorted[cellStart[cellOf(particles[pidx])]++] = pidx;
+    if (++pidx >= usedParticles) pidx = 0;
   }
-  uint16_t binIndices[maxBinParticles]; // creat array on stack for indices, 2kB max for 1024 particles (ESP32_MAXPARTICLES/2)
-  uint32_t binParticleCount; // number of particles in the current bin
-  uint32_t nextFrameStartIdx = hw_random16(usedParticles); // index of the first particle in the next frame (set to fixed value if bin overflow)
-  uint32_t pidx = collisionStartIdx; //start index in case a bin is full, process remaining particles next frame
+  // shift back so cellStart[c] is the start of cell c again
+  for (uint32_t c = numCells; c > 0; c--)
+    cellStart[c] = cellStart[c - 1];
+  cellStart[0] = 0;
 
-  // fill the binIndices array for this bin
-  for (uint32_t bin = 0; bin < numBins; bin++) {
-    binParticleCount = 0; // reset for this bin
-    int32_t binStart = bin * binWidth - overlap; // note: first bin will extend to negative, but that is ok as out of bounds particles are ignored
-    int32_t binEnd = binStart + binWidth + (overlap << 1); // add twice the overlap as start is start-overlap, note: last bin can be out of bounds, see above;
-
-    // fill the binIndices array for this bin
-    for (uint32_t i = 0; i < usedParticles; i++) {
-      if (particles[pidx].ttl > 0) { // is alive
-        if (particles[pidx].x >= binStart && particles[pidx].x <= binEnd) { // >= and <= to include particles on the edge of the bin (overlap to ensure boarder particles collide with adjacent bins)
-          if (particleFlags[pidx].outofbounds == 0 && particleFlags[pidx].collide) { // particle is in frame and does collide note: checking flags is quite slow and usually these are set, so faster to check here
-            if (binParticleCount >= maxBinParticles) { // bin is full, more particles in this bin so do the rest next frame
-              nextFrameStartIdx = pidx; // bin overflow can only happen once as bin size is at least half of the particles (or half +1)
-              break;
-            }
-            binIndices[binParticleCount++] = pidx;
-          }
-        }
+  int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
+  int32_t massratio2 = 0; // TODO: if implementing "fixed" particles, set to 1 (fixed) and 255 (movable)
+  auto checkPair = [&](uint32_t idx_i, uint32_t idx_j) {
+    if (useSize) { // using individual particle size
+      collDistSq = (PS_P_MINHARDRADIUS << 1) + ((((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) * 52) >> 6); // collision distance, use 80% of size for tighter stacking (slight overlap)
+      collDistSq = collDistSq * collDistSq; // square it for faster comparison
+      // calculate mass ratio for collision response
+      uint32_t mass1 = PS_P_RADIUS + advPartProps[idx_i].size;
+      uint32_t mass2 = PS_P_RADIUS + advPartProps[idx_j].size;
+      mass1 = mass1 * mass1; // mass proportional to area
+      mass2 = mass2 * mass2;
+      uint32_t totalmass = mass1 + mass2;
+      massratio1 = (mass2 << 8) / totalmass; // massratio 1 depends on mass of particle 2, i.e. if 2 is heavier -> higher velocity impact on 1
+      massratio2 = (mass1 << 8) / totalmass;
+    }
+    // note: using the same logic as in 1D is much slower though it would be more accurate but it is not really needed in 2D: particles slipping through each other is much less visible
+    [[maybe_unused]] bool collided = false;
+    int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+    if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+      int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+      if (dy * dy < collDistSq) { // particles are close
+        collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq, massratio1, massratio2);
+        collided = true;
       }
-      pidx++;
-      if (pidx >= usedParticles) pidx = 0; // wrap around
     }
-
-    int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
-    int32_t massratio2 = 0; // TODO: if implementing "fixed" particles, set to 1 (fixed) and 255 (movable)
-    for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
-      uint32_t idx_i = binIndices[i];
-      for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (perParticleSize && advPartProps != nullptr) { // using individual particle size
-          collDistSq = (PS_P_MINHARDRADIUS << 1) + ((((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) * 52) >> 6); // collision distance, use 80% of size for tighter stacking (slight overlap)
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-          // calculate mass ratio for collision response
-          uint32_t mass1 = PS_P_RADIUS + advPartProps[idx_i].size;
-          uint32_t mass2 = PS_P_RADIUS + advPartProps[idx_j].size;
-          mass1 = mass1 * mass1; // mass proportional to area
-          mass2 = mass2 * mass2;
-          uint32_t totalmass = mass1 + mass2;
-          massratio1 = (mass2 << 8) / totalmass; // massratio 1 depends on mass of particle 2, i.e. if 2 is heavier -> higher velocity impact on 1
-          massratio2 = (mass1 << 8) / totalmass;
+    #ifdef PIO_UNIT_TESTING
+    if (psCollisionTestHook.pair) psCollisionTestHook.pair(idx_i, idx_j, collided);
+    #endif
+  };
+
+  // each pair is checked once: within the cell and against the 4 'forward' neighbours (right column and cell below)
+  for (uint32_t cy = 0; cy < gridH; cy++) {
+    for (uint32_t cx = 0; cx < gridW; cx++) {
+      const uint32_t c = cy * gridW + cx;
+      for (uint32_t i = cellStart[c]; i < cellStart[c + 1]; i++) {
+        const uint32_t idx_i = sorted[i];
+        for (uint32_t j = i + 1; j < cellStart[c + 1]; j++)
+          checkPair(idx_i, sorted[j]);
+        for (int32_t ny = (int32_t)cy - 1; ny <= (int32_t)cy + 1; ny++) { // right column
+          if (cx + 1 >= gridW || ny < 0 || ny >= (int32_t)gridH) continue;
+          const uint32_t n = ny * gridW + cx + 1;
+          for (uint32_t j = cellStart[n]; j < cellStart[n + 1]; j++)
+            checkPair(idx_i, sorted[j]);
         }
-        // note: using the same logic as in 1D is much slower though it would be more accurate but it is not really needed in 2D: particles slipping through each other is much less visible
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq, massratio1, massratio2);
+        if (cy + 1 < gridH) { // cell below
+          const uint32_t n = c + gridW;
+          for (uint32_t j = cellStart[n]; j < cellStart[n + 1]; j++)
+            checkPair(idx_i, sorted[j]);
         }
       }
     }
   }
-  collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
@@ -1019,6 +1111,12 @@ void ParticleSystem2D::updateSystem(void) {
   //PSPRINTLN("\n END update System2D, running FX...");
 }
 
+// number of uint16_t entries in the collision grid: up to max(particles, 64) cells + 1 cell start indices and the sorted particle indices
+// rounded up to an even count so PSdataEnd stays 4 byte aligned
+static uint32_t collisionGridEntries(uint32_t numparticles) {
+  return (max(numparticles, (uint32_t)64) + 1 + numparticles + 1) & ~0x01;
+}
+
 // set the pointers for the class (this only has to be done once and not on every FX call, only the class pointer needs to be reassigned to SEGENV.data every time)
 // function returns the pointer to the next byte available for the FX (if it assigned more memory for other stuff using the above allocate function)
 // FX handles the PSsources, need to tell this function how many there are
@@ -1041,6 +1139,8 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
       PSdataEnd = reinterpret_cast<uint8_t *>(advPartSize + numParticles);
     }
   }
+  collisionGrid = reinterpret_cast<uint16_t *>(PSdataEnd);
+  PSdataEnd = reinterpret_cast<uint8_t *>(collisionGrid + collisionGridEntries(numParticles));
 #ifdef DEBUG_PS
   Serial.printf_P(PSTR(" particles %p "), particles);
   Serial.printf_P(PSTR(" sources %p "), sources);
@@ -1087,6 +1187,7 @@ bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources,
   if (sizecontrol)
     requiredmemory += sizeof(PSsizeControl) * numparticles;
   requiredmemory += sizeof(PSsource) * numsources;
+  requiredmemory += sizeof(uint16_t) * collisionGridEntries(numparticles);
   requiredmemory += additionalbytes;
   return(SEGMENT.allocateData(requiredmemory));
 }
@@ -1168,9 +1269,14 @@ ParticleSystem1D::ParticleSystem1D(uint32_t length, uint32_t numberofparticles,
 
 // update function applies gravity, moves the particles, handles collisions and renders the particles
 void ParticleSystem1D::update(void) {
-  //apply gravity globally if enabled
-  if (particlesettings.useGravity) //note: in 1D system, applying gravity after collisions also works but may be worse
-    applyGravity();
+  //apply gravity globally if enabled: collisions need the new speed, otherwise it is applied in the move loop (one pass over all particles)
+  int32_t gravitydv = 0;
+  if (particlesettings.useGravity) { //note: in 1D system, applying gravity after collisions also works but may be worse
+    if (particlesettings.useCollisions)
+      applyGravity();
+    else
+      gravitydv = calcForce_dv(gforce, gforcecounter);
+  }
 
   // handle collisions (can push particles, must be done before updating particles or they can render out of bounds, causing a crash if using local buffer for speed)
   if (particlesettings.useCollisions) {
@@ -1181,6 +1287,7 @@ void ParticleSystem1D::update(void) {
 
   //move all particles
   for (uint32_t i = 0; i < usedParticles; i++) {
+    if (gravitydv) particles[i].vx = limitSpeed((int32_t)particles[i].vx - (particleFlags[i].reversegrav ? -gravitydv : gravitydv));
     particleMoveUpdate(particles[i], particleFlags[i], nullptr, advPartProps ? &advPartProps[i] : nullptr);
   }
 
@@ -1377,6 +1484,7 @@ void ParticleSystem1D::applyForce(PSparticle1D &part, const int8_t xforce, uint8
 // force is in 3.4 fixed point notation (see above)
 void ParticleSystem1D::applyForce(const int8_t xforce) {
   int32_t dv = calcForce_dv(xforce, forcecounter); // velocity increase
+  if (dv == 0) return;
   for (uint32_t i = 0; i < usedParticles; i++) {
     particles[i].vx = limitSpeed((int32_t)particles[i].vx + dv);
   }
@@ -1385,12 +1493,11 @@ void ParticleSystem1D::applyForce(const int8_t xforce) {
 // apply gravity to all particles using PS global gforce setting
 // gforce is in 3.4 fixed point notation, see note above
 void ParticleSystem1D::applyGravity() {
-  int32_t dv_raw = calcForce_dv(gforce, gforcecounter);
+  int32_t dv = calcForce_dv(gforce, gforcecounter);
+  if (dv == 0) return;
   for (uint32_t i = 0; i < usedParticles; i++) {
-    int32_t dv = dv_raw;
-    if (particleFlags[i].reversegrav) dv = -dv_raw;
     // note: not checking if particle is dead is omitted as most are usually alive and if few are alive, rendering is fast anyways
-    particles[i].vx = limitSpeed((int32_t)particles[i].vx - dv);
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx - (particleFlags[i].reversegrav ? -dv : dv));
   }
 }
 
@@ -1408,6 +1515,7 @@ void ParticleSystem1D::applyGravity(PSparticle1D &part, PSparticleFlags1D &partF
 // slow down particle by friction, the higher the speed, the higher the friction. a high friction coefficient slows them more (255 means instant stop)
 // note: a coefficient smaller than 0 will speed them up (this is a feature, not a bug), coefficient larger than 255 inverts the speed, so don't do that
 void ParticleSystem1D::applyFriction(int32_t coefficient) {
+  if (coefficient == 0) return; // no change in speed
   #if !defined(WLED_HAVE_FAST_int_DIVIDE) // use bitshifts with rounding instead of division (2x faster)
   int32_t friction = 256 - coefficient;
   for (uint32_t i = 0; i < usedParticles; i++) {
@@ -1432,6 +1540,7 @@ void ParticleSystem1D::render() {
     PSPRINTLN(F("PS render: no framebuffer!"));
     return;
   }
+  SEGMENT.markDirty(); // framebuffer is written directly
   CRGBW baseRGB;
   uint32_t brightness; // particle brightness, fades if dying
   TBlendType blend = LINEARBLEND; // default color rendering: wrap palette
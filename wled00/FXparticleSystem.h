@@ -202,6 +202,7 @@ private:
   void applyGravity(); // applies gravity to all particles
   void handleCollisions();
   void collideParticles(PSparticle &particle1, PSparticle &particle2, int32_t dx, int32_t dy, const uint32_t collDistSq, int32_t massratio1, int32_t massratio2);
+  [[gnu::hot]] void moveParticles(const int32_t gravitydv); // particleMoveUpdate() for all particles using PS settings, applies gravity speed change if not 0
   void fireParticleupdate();
   //utility functions
   void updatePSpointers(const bool isadvanced, const bool sizecontrol); // update the data pointers to current segment data space
@@ -210,6 +211,7 @@ private:
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   uint32_t *framebuffer; // frame buffer for rendering. note: using CRGBW as the buffer is slower, ESP compiler seems to optimize this better giving more consistent FPS
+  uint16_t *collisionGrid; // scratch memory for handleCollisions(), located in segment data after the particle arrays
   PSsettings2D particlesettings; // settings used when updating particles (can also used by FX to move sources), do not edit properties directly, use functions above
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
@@ -217,7 +219,6 @@ private:
   uint32_t wallHardness;
   uint32_t wallRoughness; // randomizes wall collisions
   uint32_t particleHardRadius; // hard surface radius of a particle, used for collision detection (32bit for speed)
-  uint16_t collisionStartIdx; // particle array start index for collision detection
   uint8_t fireIntesity = 0; // fire intensity, used for fire mode (flash use optimization, better than passing an argument to render function)
   uint8_t forcecounter; // counter for globally applied forces
   uint8_t gforcecounter; // counter for global gravity
@@ -228,6 +229,15 @@ private:
   uint8_t smearBlur; // 2D smeared blurring of full frame
 };
 
+#ifdef PIO_UNIT_TESTING
+// unit test hook (test_ps_collisions): ParticleSystem2D::handleCollisions() reports its input and every pair it tests
+struct PSCollisionTestHook {
+  void (*begin)(const ParticleSystem2D &ps, uint32_t collDist); // before particles are sorted into grid (collDist: largest collision distance)
+  void (*pair)(uint32_t i, uint32_t j, bool collided);          // pair of particle indices tested, collided if they were close
+};
+extern PSCollisionTestHook psCollisionTestHook;
+#endif
+
 // initialization functions (not part of class)
 bool initParticleSystem2D(ParticleSystem2D *&PartSys, const uint32_t requestedsources, const uint32_t additionalbytes = 0, const bool advanced = false, const bool sizecontrol = false);
 uint32_t calculateNumberOfParticles2D(const uint32_t pixels, const bool advanced, const bool sizecontrol);
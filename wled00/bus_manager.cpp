@@ -66,6 +66,25 @@ uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaul
   return defaultColorOrder;
 }
 
+// same as above but also returns pixel range [lo,hi) for which the returned color order is valid
+// used to avoid searching the map for every pixel when a span of pixels is set
+uint8_t IRAM_ATTR ColorOrderMap::getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder, unsigned &lo, unsigned &hi) const {
+  lo = 0;
+  hi = UINT16_MAX + 1U;
+  for (const auto& map : _mappings) {
+    const unsigned mapEnd = map.start + map.len;
+    if (pix >= map.start && pix < mapEnd) {
+      if (map.start > lo) lo = map.start;
+      if (mapEnd < hi)    hi = mapEnd;
+      return map.colorOrder | ((map.colorOrder >> 4) ? 0 : (defaultColorOrder & 0xF0));
+    }
+    // earlier entries take precedence, narrow the range so it does not overlap them
+    if (map.start > pix) { if (map.start < hi) hi = map.start; }
+    else if (mapEnd > lo) lo = mapEnd;
+  }
+  return defaultColorOrder;
+}
+
 
 void Bus::calculateCCT(uint32_t c, uint8_t &ww, uint8_t &cw) {
   unsigned cct = 0; //0 - full warm white, 255 - full cold white
@@ -266,12 +285,11 @@ void BusDigital::setStatusPixel(uint32_t c) {
   }
 }
 
-// note: using WLED_O2_ATTR makes this function ~7% faster at the expense of 600 bytes of flash
-void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
-  if (!_valid) return;
+// common color processing for setPixelColor() and setPixels()
+inline uint32_t BusDigital::scaleColor(uint32_t c, uint16_t &wwcw) {
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
   uint8_t cctWW = 0, cctCW = 0;
-  uint16_t wwcw = 0;
+  wwcw = 0;
   if (hasWhite()) c = autoWhiteCalc(c, cctWW, cctCW);
   c = color_fade(c, _bri, true); // apply brightness
 
@@ -290,6 +308,14 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
       _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
     }
   }
+  return c;
+}
+
+// note: using WLED_O2_ATTR makes this function ~7% faster at the expense of 600 bytes of flash
+void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid) return;
+  uint16_t wwcw;
+  c = scaleColor(c, wwcw);
 
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
@@ -308,6 +334,26 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+// set a span of pixels: bus validity, color order and type checks are done once per span instead of once per pixel
+// note: no bounds checking, BusManager::setPixels() clips span to bus
+void IRAM_ATTR BusDigital::setPixels(unsigned pix, const uint32_t *c, size_t count) {
+  if (!_valid) return;
+  if (_type == TYPE_WS2812_1CH_X3) { // each IC controls 3 LEDs, needs read-modify-write
+    for (size_t i = 0; i < count; i++) setPixelColor(pix + i, c[i]);
+    return;
+  }
+  const bool useMap = _colorOrderMap.count() > 0; // color order lookup is a linear search, avoid it if there is no map
+  uint8_t  co = _colorOrder;
+  unsigned coLo = 1, coHi = 0; // range of pixels for which co is valid (empty: force lookup)
+  for (size_t i = 0; i < count; i++) {
+    uint16_t wwcw;
+    uint32_t col = scaleColor(c[i], wwcw);
+    unsigned p = (_reversed ? _len - (pix + i) - 1 : pix + i) + _skip;
+    if (useMap && (p + _start < coLo || p + _start >= coHi)) co = _colorOrderMap.getPixelColorOrder(p + _start, _colorOrder, coLo, coHi);
+    PolyBus::setPixelColor(_busPtr, _iType, p, col, co, wwcw);
+  }
+}
+
 // returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -713,6 +759,7 @@ BusNetwork::BusNetwork(const BusConfig &bc)
       _UDPtype = 2;
       break;
     case TYPE_NET_E131_RGB:
+    case TYPE_NET_E131_RGBW:
       _UDPtype = 1;
       break;
     default: // TYPE_NET_DDP_RGB / TYPE_NET_DDP_RGBW
@@ -723,7 +770,8 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   _hasWhite = hasWhite(bc.type);
   _hasCCT = false;
   _UDPchannels = _hasWhite + 3;
-  _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _clients[0] = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _numClients = 1;
   #ifdef ARDUINO_ARCH_ESP32
   _hostname = bc.text;
   resolveHostname(); // resolve hostname to IP address if needed
@@ -745,6 +793,23 @@ void BusNetwork::setPixelColor(unsigned pix, uint32_t c) {
   if (_hasWhite) _data[offset+3] = W(c);
 }
 
+void BusNetwork::setPixels(unsigned pix, const uint32_t *c, size_t count) {
+  if (!_valid || pix >= _len) return;
+  if (pix + count > _len) count = _len - pix;
+  const bool wbCorrection = Bus::_cct >= 1900;
+  uint8_t *dst = _data + pix * _UDPchannels;
+  for (size_t i = 0; i < count; i++) {
+    uint32_t col = c[i];
+    uint8_t ww, cw; // dummy, unused
+    if (_hasWhite) col = autoWhiteCalc(col, ww, cw);
+    if (wbCorrection) col = colorBalanceFromKelvin(Bus::_cct, col); //color correction from CCT
+    *dst++ = R(col);
+    *dst++ = G(col);
+    *dst++ = B(col);
+    if (_hasWhite) *dst++ = W(col);
+  }
+}
+
 uint32_t BusNetwork::getPixelColor(unsigned pix) const {
   if (!_valid || pix >= _len) return 0;
   unsigned offset = pix * _UDPchannels;
@@ -754,35 +819,51 @@ uint32_t BusNetwork::getPixelColor(unsigned pix) const {
 void BusNetwork::show() {
   if (!_valid || !canShow()) return;
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
+  realtimeBroadcast(_UDPtype, _clients, _numClients, _len, _data, _bri, hasWhite());
   _broadcastLock = false;
 }
 
 size_t BusNetwork::getPins(uint8_t* pinArray) const {
-  if (pinArray) for (unsigned i = 0; i < 4; i++) pinArray[i] = _client[i];
+  if (pinArray) for (unsigned i = 0; i < 4; i++) pinArray[i] = _clients[0][i];
   return 4;
 }
 
 #ifdef ARDUINO_ARCH_ESP32
+// host field may contain a comma separated list of host names and/or IP addresses, data is sent to each of them
+// first entry replaces IP address from bus configuration, entries that fail to resolve keep their previous address
+// lookups share WLED_NET_RESOLVE_MS (blocking call), names not resolved in time are retried on next resolve
 void BusNetwork::resolveHostname() {
   static std::shared_ptr<AsyncDNS> DNSlookup; // TODO: make this dynamic? requires to handle the callback properly
-  if (WLEDNetwork.isConnected()) {
+  if (_hostname.length() == 0 || !WLEDNetwork.isConnected()) return;
+  unsigned names = 1; // entries that may need a lookup (upper bound)
+  for (size_t i = 0; i < _hostname.length(); i++) names += _hostname[i] == ',';
+  const unsigned long start = millis();
+  unsigned n = 0;
+  for (int from = 0; from <= (int)_hostname.length() && n < WLED_NET_MAX_DESTINATIONS; names--) {
+    int to = _hostname.indexOf(',', from);
+    if (to < 0) to = _hostname.length();
+    String host = _hostname.substring(from, to);
+    host.trim();
+    from = to + 1;
+    if (host.length() == 0) continue;
     IPAddress clnt;
-    if (strlen(cmDNS) > 0) {
-      clnt = MDNS.queryHost(_hostname);
-      if (clnt != IPAddress()) _client = clnt; // update client IP if not null
-    }
-    else {
-      int timeout = 5000; // 5 seconds timeout
-      DNSlookup = AsyncDNS::query(_hostname.c_str(), DNSlookup); // start async DNS query
-      while (DNSlookup->status() == AsyncDNS::result::Busy && timeout-- > 0) {
-        delay(1);
-      }
-      if (DNSlookup->status() == AsyncDNS::result::Success) {
-        _client = DNSlookup->getIP(); // update client IP
+    unsigned long elapsed = millis() - start;
+    if (!clnt.fromString(host) && elapsed < WLED_NET_RESOLVE_MS) {
+      unsigned timeout = (WLED_NET_RESOLVE_MS - elapsed) / max(names, 1U); // fair share of remaining time
+      if (strlen(cmDNS) > 0) {
+        clnt = MDNS.queryHost(host, timeout);
+      } else {
+        DNSlookup = AsyncDNS::query(host.c_str(), DNSlookup); // start async DNS query
+        while (DNSlookup->status() == AsyncDNS::result::Busy && timeout-- > 0) {
+          delay(1);
+        }
+        if (DNSlookup->status() == AsyncDNS::result::Success) clnt = DNSlookup->getIP();
       }
     }
+    if (clnt != IPAddress()) _clients[n] = clnt; // update client IP if not null
+    n++;
   }
+  if (n) _numClients = n;
 }
 #endif
 
@@ -793,6 +874,8 @@ std::vector<LEDType> BusNetwork::getLEDTypes() {
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
+    {TYPE_NET_E131_RGBW,   "N",     PSTR("E1.31 RGBW (network)")},
     // hypothetical extensions
     //{TYPE_VIRTUAL_I2C_W,   "V",     PSTR("I2C White (virtual)")}, // allows setting I2C address in _pin[0]
     //{TYPE_VIRTUAL_I2C_CCT, "V",     PSTR("I2C CCT (virtual)")}, // allows setting I2C address in _pin[0]
@@ -1160,6 +1243,11 @@ void IRAM_ATTR BusHub75Matrix::setPixelColor(unsigned pix, uint32_t c) {
   }
 }
 
+void IRAM_ATTR BusHub75Matrix::setPixels(unsigned pix, const uint32_t *c, size_t count) {
+  if (!_valid) return;
+  for (size_t i = 0; i < count; i++) BusHub75Matrix::setPixelColor(pix + i, c[i]); // non-virtual call
+}
+
 uint32_t BusHub75Matrix::getPixelColor(unsigned pix) const {
   if (!_valid) return IS_BLACK; // note: no need to check pix >= _len as that is checked in containsPixel()
   if (_ledBuffer)
@@ -1449,6 +1537,19 @@ void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
   }
 }
 
+// sets a span of consecutive physical pixels, span is split at bus boundaries
+void IRAM_ATTR BusManager::setPixels(unsigned pix, const uint32_t *c, size_t count) {
+  const unsigned end = pix + count;
+  for (auto &bus : busses) {
+    const unsigned bstart = bus->getStart();
+    const unsigned bend   = bstart + bus->getLength();
+    const unsigned s = std::max(pix, bstart);
+    const unsigned e = std::min(end, bend);
+    if (s >= e) continue;
+    bus->setPixels(s - bstart, c + (s - pix), e - s);
+  }
+}
+
 void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   if (cct > 255) cct = 255;
   if (cct >= 0) {
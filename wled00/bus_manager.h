@@ -96,6 +96,7 @@ struct ColorOrderMap {
     }
 
     [[gnu::hot]] uint8_t getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder) const;
+    [[gnu::hot]] uint8_t getPixelColorOrder(uint16_t pix, uint8_t defaultColorOrder, unsigned &lo, unsigned &hi) const; // also returns range [lo,hi) with same color order
 
   private:
     std::vector<ColorOrderMapEntry> _mappings;
@@ -132,6 +133,7 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    virtual void     setPixels(unsigned pix, const uint32_t *c, size_t count) { for (size_t i = 0; i < count; i++) setPixelColor(pix + i, c[i]); } // set span of pixels starting at pix (no bounds check)
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -181,7 +183,8 @@ class Bus {
               type == TYPE_SK6812_RGBW || type == TYPE_TM1814 || type == TYPE_UCS8904 ||
               type == TYPE_FW1906 || type == TYPE_WS2805 || type == TYPE_SM16825 ||        // digital types with white channel
               (type > TYPE_ONOFF && type <= TYPE_ANALOG_5CH && type != TYPE_ANALOG_3CH) || // analog types with white channel
-              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW;                   // network types with white channel
+              type == TYPE_NET_DDP_RGBW || type == TYPE_NET_ARTNET_RGBW ||                 // network types with white channel
+              type == TYPE_NET_E131_RGBW;
     }
     static constexpr bool hasCCT(uint8_t type) {
       return  type == TYPE_WS2812_WWA    || type == TYPE_SM16825 ||
@@ -254,6 +257,7 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *c, size_t count) override;
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -289,6 +293,8 @@ class BusDigital : public Bus {
 
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
+    inline uint32_t scaleColor(uint32_t c, uint16_t &wwcw); // applies white balance, auto white, brightness & CCT, sums ABL current
+
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
         uint8_t* chan = (uint8_t*) &c;
@@ -308,6 +314,7 @@ class BusPwm : public Bus {
     ~BusPwm() { cleanup(); }
 
     void setPixelColor(unsigned pix, uint32_t c) override;
+    void setPixels(unsigned pix, const uint32_t *c, size_t count) override { if (pix == 0 && count) setPixelColor(0, c[0]); } // only first pixel is used
     uint32_t getPixelColor(unsigned pix) const override; //does no index check
     size_t   getPins(uint8_t* pinArray = nullptr) const override;
     uint16_t getFrequency() const override { return _frequency; }
@@ -336,6 +343,7 @@ class BusOnOff : public Bus {
     ~BusOnOff() { cleanup(); }
 
     void setPixelColor(unsigned pix, uint32_t c) override;
+    void setPixels(unsigned pix, const uint32_t *c, size_t count) override { if (pix == 0 && count) setPixelColor(0, c[0]); } // only first pixel is used
     uint32_t getPixelColor(unsigned pix) const override;
     size_t   getPins(uint8_t* pinArray) const override;
     size_t   getBusSize() const override { return sizeof(BusOnOff); }
@@ -350,6 +358,17 @@ class BusOnOff : public Bus {
 };
 
 
+// a network bus can send the same data to several receivers (comma separated host list)
+#ifdef ESP8266
+  #define WLED_NET_MAX_DESTINATIONS 1
+#else
+  #define WLED_NET_MAX_DESTINATIONS 4
+#endif
+#define WLED_NET_HOSTS_MAXLEN (WLED_NET_MAX_DESTINATIONS * 32 - 1) // host field: a name of up to 31 characters per destination + commas
+#ifndef WLED_NET_RESOLVE_MS
+  #define WLED_NET_RESOLVE_MS 2000 // longest time BusNetwork::resolveHostname() blocks for all destinations together
+#endif
+
 class BusNetwork : public Bus {
   public:
     BusNetwork(const BusConfig &bc);
@@ -357,6 +376,7 @@ class BusNetwork : public Bus {
 
     bool canShow() const override  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *c, size_t count) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     size_t getPins(uint8_t* pinArray = nullptr) const override;
     size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels : 0); }
@@ -370,7 +390,8 @@ class BusNetwork : public Bus {
     static std::vector<LEDType> getLEDTypes();
 
   private:
-    IPAddress _client;
+    IPAddress _clients[WLED_NET_MAX_DESTINATIONS];
+    uint8_t   _numClients;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
     bool      _broadcastLock;
@@ -389,6 +410,7 @@ class BusPlaceholder : public Bus {
 
     // Actual calls are stubbed out
     void setPixelColor(unsigned pix, uint32_t c) override {};
+    void setPixels(unsigned pix, const uint32_t *c, size_t count) override {};
     void show() override {};
 
     // Accessors
@@ -420,6 +442,7 @@ class BusHub75Matrix : public Bus {
   public:
     BusHub75Matrix(const BusConfig &bc);
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixels(unsigned pix, const uint32_t *c, size_t count) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     void show() override;
     void setBrightness(uint8_t b) override;
@@ -560,6 +583,7 @@ namespace BusManager {
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  [[gnu::hot]] void     setPixels(unsigned pix, const uint32_t *c, size_t count); // set span of (physical) pixels, may cross bus boundaries
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
   void        show();
   bool        canAllShow();
@@ -606,6 +606,7 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   JsonObject if_live_dmx = if_live["dmx"];
   CJSON(e131Universe, if_live_dmx[F("uni")]);
   CJSON(e131SkipOutOfSequence, if_live_dmx[F("seqskip")]);
+  CJSON(e131FrameTimeout, if_live_dmx[F("ftmo")]);
   CJSON(DMXAddress, if_live_dmx[F("addr")]);
   if (!DMXAddress || DMXAddress > 510) DMXAddress = 1;
   CJSON(DMXSegmentSpacing, if_live_dmx[F("dss")]);
@@ -1149,6 +1150,7 @@ void serializeConfig(JsonObject root) {
   JsonObject if_live_dmx = if_live.createNestedObject("dmx");
   if_live_dmx[F("uni")] = e131Universe;
   if_live_dmx[F("seqskip")] = e131SkipOutOfSequence;
+  if_live_dmx[F("ftmo")] = e131FrameTimeout;
   if_live_dmx[F("e131prio")] = e131Priority;
   if_live_dmx[F("addr")] = DMXAddress;
   if_live_dmx[F("dss")] = DMXSegmentSpacing;
@@ -590,19 +590,19 @@ static inline float maxf(float v, float w)
 
 // adjust RGB values based on color temperature in K (range [2800-10200]) (https://en.wikipedia.org/wiki/Color_balance)
 // called from bus manager when color correction is enabled!
-uint32_t colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb)
+uint32_t IRAM_ATTR_YN colorBalanceFromKelvin(uint16_t kelvin, uint32_t rgb)
 {
   //remember so that slow colorKtoRGB() doesn't have to run for every setPixelColor()
-  static byte correctionRGB[4] = {0,0,0,0};
+  //per channel correction is stored as lookup table, avoids 3 divisions per pixel (slow on C3/C6 and ESP8266)
+  static byte balanceLUT[3][256];
   static uint16_t lastKelvin = 0;
-  if (lastKelvin != kelvin) colorKtoRGB(kelvin, correctionRGB);  // convert Kelvin to RGB
-  lastKelvin = kelvin;
-  byte rgbw[4];
-  rgbw[0] = ((uint16_t) correctionRGB[0] * R(rgb)) /255; // correct R
-  rgbw[1] = ((uint16_t) correctionRGB[1] * G(rgb)) /255; // correct G
-  rgbw[2] = ((uint16_t) correctionRGB[2] * B(rgb)) /255; // correct B
-  rgbw[3] =                                W(rgb);
-  return RGBW32(rgbw[0],rgbw[1],rgbw[2],rgbw[3]);
+  if (lastKelvin != kelvin) {
+    byte correctionRGB[4] = {0,0,0,0};
+    colorKtoRGB(kelvin, correctionRGB);  // convert Kelvin to RGB
+    for (unsigned c = 0; c < 3; c++) for (unsigned v = 0; v < 256; v++) balanceLUT[c][v] = ((uint16_t) correctionRGB[c] * v) / 255;
+    lastKelvin = kelvin;
+  }
+  return RGBW32(balanceLUT[0][R(rgb)], balanceLUT[1][G(rgb)], balanceLUT[2][B(rgb)], W(rgb));
 }
 
 //approximates a Kelvin color temperature from an RGB color.
@@ -384,10 +384,11 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //Network types (master broadcast) (80-95)
 #define TYPE_VIRTUAL_MIN         80
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGBW     89            //network ArtNet RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGBW       90            //network E131 RGBW bus (master broadcast bus)
 #define TYPE_VIRTUAL_MAX         95
 
 //Color orders
@@ -662,6 +663,18 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #endif
 #endif
 
+// number of JSON documents available to API requests (pDoc + documents allocated on first use, see acquireJSONDocument())
+#ifdef ESP8266
+  #undef WLED_JSON_POOL_SIZE
+  #define WLED_JSON_POOL_SIZE 1 // only pDoc, there is no RAM for more
+#elif !defined(WLED_JSON_POOL_SIZE)
+  #ifdef BOARD_HAS_PSRAM
+    #define WLED_JSON_POOL_SIZE 4
+  #else
+    #define WLED_JSON_POOL_SIZE 2
+  #endif
+#endif
+
 // minimum heap size required to process web requests: try to keep free heap above this value
 #ifdef ESP8266
   #define MIN_HEAP_SIZE (9*1024)
@@ -1,4 +1,5 @@
 #include "wled.h"
+#include <atomic>
 
 #define MAX_3_CH_LEDS_PER_UNIVERSE 170
 #define MAX_4_CH_LEDS_PER_UNIVERSE 128
@@ -9,6 +10,71 @@ static void handleDDPPacket(e131_packet_t* p, size_t packetLen);
 static void handleArtnetPollReply(IPAddress ipAddress);
 static void prepareArtnetPollReply(ArtPollReply *reply);
 static void sendArtnetPollReply(ArtPollReply *reply, IPAddress ipAddress, uint16_t portAddress);
+static unsigned getE131UniverseCount();
+
+#define E131_SYNC_TIMEOUT 2500 // ms without sync packet after which we stop waiting for them
+
+/*
+ * Frame assembly for multi-universe modes
+ * Strip is shown once all universes of a frame have arrived, a sync packet (Art-Net OpSync, E1.31 synchronization)
+ * is received or e131FrameTimeout expires; instead of on every received universe (tearing across universes).
+ * Universe state is updated from async UDP task, deadline is checked from loop() in handleE131Frame(), so the
+ * universe mask is only changed with atomic or/exchange and each received universe is shown exactly once.
+ */
+static_assert(E131_MAX_UNIVERSE_COUNT <= 32, "frame assembly uses 32 bit universe mask");
+static std::atomic<uint32_t> frameUniverses{0};   // bit n set: universe (e131Universe + n) received for current frame
+static volatile unsigned long frameStart = 0;     // arrival of first universe of current frame
+static volatile unsigned long lastSyncPacket = 0; // sender uses sync packets, don't show before sync arrives
+static volatile uint16_t lateCount = 0;           // out-of-sequence packets in current statistics window
+static volatile uint16_t droppedCount = 0;        // universes missing from shown frames in current statistics window
+
+static inline bool isE131SyncActive() {
+  return lastSyncPacket && millis() - lastSyncPacket < E131_SYNC_TIMEOUT;
+}
+
+static inline uint32_t getE131UniverseMask() {
+  const unsigned expected = getE131UniverseCount();
+  return expected >= 32 ? UINT32_MAX : (1UL << expected) - 1;
+}
+
+// shows a frame assembled from received universes (taken from frameUniverses by caller)
+static void showE131Frame(uint32_t received) {
+  if (!received) return; // already shown by other task
+  droppedCount += __builtin_popcount(getE131UniverseMask() & ~received);
+  e131NewData = true;
+}
+
+static inline void showE131Frame() {
+  showE131Frame(frameUniverses.exchange(0));
+}
+
+static void addE131Universe(unsigned index) {
+  const uint32_t bit = 1UL << index;
+  uint32_t received = frameUniverses.fetch_or(bit);
+  if (received & bit) {
+    // same universe again: sender moved on to next frame, show what we have and start new frame with this universe
+    showE131Frame(frameUniverses.exchange(bit));
+    received = 0;
+  }
+  if (!received) frameStart = millis();
+  received |= bit;
+  if (isE131SyncActive()) return; // sync packet will trigger show
+  const uint32_t expectedMask = getE131UniverseMask();
+  if ((received & expectedMask) == expectedMask) showE131Frame();
+}
+
+// called from loop(): show incomplete frames once e131FrameTimeout expired and update statistics
+void handleE131Frame() {
+  static unsigned long statStart = 0;
+  if (frameUniverses && millis() - frameStart >= e131FrameTimeout) showE131Frame();
+  if (millis() - statStart >= 1000) {
+    e131LatePerSec    = lateCount;
+    e131DroppedPerSec = droppedCount;
+    lateCount    = 0;
+    droppedCount = 0;
+    statStart    = millis();
+  }
+}
 
 
 /*
@@ -78,11 +144,7 @@ static void handleDDPPacket(e131_packet_t* p, size_t packetLen) {
   if (realtimeMode != REALTIME_MODE_DDP) ddpSeenPush = false; // just starting, no push yet
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
-  if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
-  }
+  if (!realtimeOverride) setRealtimePixels(start, &data[c], numLeds, ddpChannelsPerLed);
 
   ddpSeenPush |= push;
   if (!ddpSeenPush || push) { // if we've never seen a push, or this is one, render display
@@ -93,7 +155,15 @@ static void handleDDPPacket(e131_packet_t* p, size_t packetLen) {
 }
 
 //E1.31 and Art-Net protocol support
+static void processE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t packetLen);
+
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t packetLen){
+  unsigned long packetStart = micros();
+  processE131Packet(p, clientIP, protocol, packetLen);
+  countRealtimePacket(packetStart);
+}
+
+static void processE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t packetLen){
 
   int uni = 0, dmxChannels = 0;
   uint8_t* e131_data = nullptr;
@@ -106,6 +176,11 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_
       handleArtnetPollReply(clientIP);
       return;
     }
+    if (p->art_opcode == ARTNET_OPCODE_OPSYNC) {
+      lastSyncPacket = millis();
+      if (frameUniverses) showE131Frame();
+      return;
+    }
     if (packetLen < 18) return; // need art_length (offset 16, 2 bytes) for DMX data
     uni = p->art_universe;
     dmxChannels = htons(p->art_length);
@@ -116,6 +191,12 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_
     seq = p->art_sequence_number;
     mde = REALTIME_MODE_ARTNET;
   } else if (protocol == P_E131) {
+    if (packetLen >= E131_SYNC_PACKET_LEN && htonl(p->root_vector) == E131_VECTOR_ROOT_EXTENDED) {
+      // synchronization packet (no DMX data), only frame_vector is validated by ESPAsyncE131
+      lastSyncPacket = millis();
+      if (frameUniverses) showE131Frame();
+      return;
+    }
     if (packetLen < 126) return; // need up to property_values[0] (offset 125) and property_value_count (offset 123)
     // Ignore PREVIEW data (E1.31: 6.2.6)
     if ((p->options & 0x80) != 0) return;
@@ -156,6 +237,9 @@ void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_
 
   unsigned previousUniverses = uni - e131Universe;
 
+  // sequence number 0 means sequence is not used (Art-Net), wrap-around is handled by signed 8 bit difference
+  if (seq != 0 && int8_t(seq - e131LastSequenceNumber[previousUniverses]) < 0) lateCount++;
+
   if (e131SkipOutOfSequence)
     if (seq < e131LastSequenceNumber[previousUniverses] && seq > 20 && e131LastSequenceNumber[previousUniverses] < 250){
       DEBUG_PRINTF_P(PSTR("skipping E1.31 frame (last seq=%d, current seq=%d, universe=%d)\n"), e131LastSequenceNumber[previousUniverses], seq, uni);
@@ -363,10 +447,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, &e131_data[dmxOffset], ledsTotal - previousLeds, dmxChannelsPerLed);
         break;
       }
     default:
@@ -375,19 +456,19 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
       break;
   }
 
-  e131NewData = true;
+  // assemble multi-universe frames (0 timeout: show every universe as it arrives)
+  if ((mde == REALTIME_MODE_E131 || mde == REALTIME_MODE_ARTNET) && e131FrameTimeout > 0) addE131Universe(previousUniverses);
+  else e131NewData = true;
 }
 
-static void handleArtnetPollReply(IPAddress ipAddress) {
-  ArtPollReply artnetPollReply;
-  prepareArtnetPollReply(&artnetPollReply);
-
+// returns number of consecutive universes (starting at e131Universe) used by current DMX mode, 0 if disabled
+static unsigned getE131UniverseCount() {
   unsigned startUniverse = e131Universe;
   unsigned endUniverse = e131Universe;
 
   switch (DMXMode) {
     case DMX_MODE_DISABLED:
-      break;
+      return 0;
 
     case DMX_MODE_SINGLE_RGB:
     case DMX_MODE_SINGLE_DRGB:
@@ -427,18 +508,22 @@ static void handleArtnetPollReply(IPAddress ipAddress) {
       }
     default:
       DEBUG_PRINTLN(F("unknown E1.31 DMX mode"));
-      return;  // nothing to do
-      break;
+      return 0;  // nothing to do
   }
+  return endUniverse - startUniverse + 1;
+}
 
-  if (DMXMode != DMX_MODE_DISABLED) {
-    for (unsigned i = startUniverse; i <= endUniverse; ++i) {
-      sendArtnetPollReply(&artnetPollReply, ipAddress, i);
-    }
+static void handleArtnetPollReply(IPAddress ipAddress) {
+  ArtPollReply artnetPollReply;
+  prepareArtnetPollReply(&artnetPollReply);
+
+  const unsigned universeCount = getE131UniverseCount();
+  for (unsigned i = 0; i < universeCount; ++i) {
+    sendArtnetPollReply(&artnetPollReply, ipAddress, e131Universe + i);
   }
 
   #ifdef WLED_ENABLE_DMX
-    if (e131ProxyUniverse > 0 && (DMXMode == DMX_MODE_DISABLED || (e131ProxyUniverse < startUniverse || e131ProxyUniverse > endUniverse))) {
+    if (e131ProxyUniverse > 0 && (e131ProxyUniverse < e131Universe || e131ProxyUniverse >= e131Universe + universeCount)) {
       sendArtnetPollReply(&artnetPollReply, ipAddress, e131ProxyUniverse);
     }
   #endif
@@ -111,6 +111,7 @@ void handleDMXInput();
 //e131.cpp
 void handleE131Packet(e131_packet_t* p, IPAddress clientIP, byte protocol, size_t packetLen);
 void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8_t mde, uint8_t previousUniverses);
+void handleE131Frame();
 // void handleArtnetPollReply(IPAddress ipAddress);                                          // local function, only used in e131.cpp
 // void prepareArtnetPollReply(ArtPollReply* reply);                                         // local function, only used in e131.cpp
 // void sendArtnetPollReply(ArtPollReply* reply, IPAddress ipAddress, uint16_t portAddress); // local function, only used in e131.cpp
@@ -150,9 +151,14 @@ unsigned long filePositionCallback(void);
 int fileReadCallback(void);
 int fileReadBlockCallback(void * buffer, int numberOfBytes);
 int fileSizeCallback(void);
+#endif
+#if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
 byte renderImageToSegment(Segment &seg);
 void endImagePlayback(Segment* seg);
 #endif
+#ifdef WLED_ENABLE_FSEQ
+bool getFseqPlaybackStats(uint32_t &frame, uint32_t &frames, uint32_t &dropped);
+#endif
 
 //improv.cpp
 enum ImprovRPCType {
@@ -296,11 +302,14 @@ bool handleSet(AsyncWebServerRequest *request, const String& req, bool apply=tru
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, size_t numClients, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+inline uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false) { return realtimeBroadcast(type, &client, 1, length, buffer, bri, isRGBW); }
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(unsigned start, const uint8_t *data, size_t count, unsigned channels);
+void countRealtimePacket(unsigned long startUs);
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -455,6 +464,32 @@ uint32_t utf8_decode(const char *s, uint8_t *len);
 size_t utf8_strlen(const char *s);
 bool requestJSONBufferLock(uint8_t moduleID=JSON_LOCK_UNKNOWN);
 void releaseJSONBufferLock();
+void initJSONPool();
+JsonDocument *acquireJSONDocument(uint8_t moduleID=JSON_LOCK_UNKNOWN); // any free document of the pool (may be pDoc), nullptr on timeout
+void releaseJSONDocument(JsonDocument *doc);
+bool lockJSONState(uint8_t moduleID=JSON_LOCK_UNKNOWN); // must be held while a pool document is (de)serialized from/to WLED state
+void unlockJSONState();
+void countJSONDeferral(); // HTTP response deferred or WS message dropped as no document was available
+struct JSONPoolStats {
+  uint32_t acquired;  // documents handed out (including pDoc)
+  uint32_t waited;    // requests that had to wait for a document
+  uint32_t waitMs;    // total time spent waiting
+  uint32_t maxWaitMs;
+  uint32_t failed;    // requests that timed out
+  uint32_t deferred;  // see countJSONDeferral()
+  uint8_t  inUse, peak;
+  uint8_t  owner[WLED_JSON_POOL_SIZE]; // module ID (JSON_LOCK_*) holding each document, 0 = free; pDoc first
+};
+JSONPoolStats getJSONPoolStats();
+// time each JSON_LOCK_* owner waited for the global JSON lock (pDoc mutex, also taken by lockJSONState())
+struct JSONLockWait {
+  uint32_t locks;     // lock requests that succeeded
+  uint32_t waitMs;    // total time spent waiting
+  uint16_t maxWaitMs;
+  uint16_t failed;    // lock requests that timed out
+};
+#define JSON_LOCK_IDS (JSON_LOCK_OTA + 1) // entry 0 collects JSON_LOCK_UNKNOWN and usermod IDs
+const JSONLockWait *getJSONLockWaits(); // JSON_LOCK_IDS entries, indexed by module ID
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -176,7 +176,135 @@ static void writeSpace(size_t l)
   if (knownLargestSpace < l) knownLargestSpace = l;
 }
 
-static bool appendObjectToFile(const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0)
+/*
+ * Preset index: offset and length of each preset object in presets.json, so applying a preset is a seek and a
+ * single read instead of a scan of the whole file. Built in one pass on first lookup, kept up to date by
+ * writeObjectToFile() and rebuilt if presets.json was replaced behind our back (upload, size mismatch).
+ */
+#define PRESET_INDEX_SIZE 251 // ids 0-250 (255 lives in tmp.json or RAM)
+
+static struct {
+  uint32_t *offset;   // position of object's '{', 0 if preset does not exist
+  uint16_t *length;   // object length, 0 if too large to read in one go
+  size_t    fileSize; // size of presets.json the index matches, 0 to adopt current size (after own writes)
+  byte      validate; // cacheInvalidate at build time
+  bool      valid;
+} presetIndex = {nullptr, nullptr, 0, 0, false};
+
+static bool isPresetsFile(const char *fileName) {
+  return strcmp_P(fileName, getPresetsFileName()) == 0;
+}
+
+static bool isPresetIndexCurrent(size_t fileSize) {
+  if (!presetIndex.valid || presetIndex.validate != cacheInvalidate) return false;
+  if (presetIndex.fileSize == 0) presetIndex.fileSize = fileSize;
+  return presetIndex.fileSize == fileSize;
+}
+
+// single pass over presets.json recording where each root-level object starts and ends
+static bool buildPresetIndex(File &file) {
+  #ifdef WLED_DEBUG_FS
+    uint32_t s = millis();
+  #endif
+  presetIndex.valid = false;
+  if (!presetIndex.offset) {
+    presetIndex.offset = static_cast<uint32_t*>(d_malloc(PRESET_INDEX_SIZE * (sizeof(uint32_t) + sizeof(uint16_t))));
+    if (!presetIndex.offset) return false;
+    presetIndex.length = reinterpret_cast<uint16_t*>(presetIndex.offset + PRESET_INDEX_SIZE);
+  }
+  memset(presetIndex.offset, 0, PRESET_INDEX_SIZE * (sizeof(uint32_t) + sizeof(uint16_t)));
+
+  byte buf[FS_BUFSIZE];
+  unsigned depth = 0;
+  int  key = -1;         // id of current root-level key, -1 if not a valid preset id
+  uint32_t start = 0;    // start of current root-level object
+  bool inString = false, escape = false;
+  file.seek(0);
+  for (uint32_t pos = 0; file.available(); ) {
+    size_t len = file.read(buf, sizeof(buf));
+    if (!len) break;
+    for (size_t i = 0; i < len; i++, pos++) {
+      const char c = buf[i];
+      if (inString) {
+        if (escape) escape = false;
+        else if (c == '\\') escape = true;
+        else if (c == '"') inString = false;
+        else if (depth == 1 && key >= 0) key = (c >= '0' && c <= '9' && key < PRESET_INDEX_SIZE) ? key * 10 + c - '0' : -1;
+        continue;
+      }
+      switch (c) {
+        case '"':
+          inString = true;
+          if (depth == 1) key = 0; // root-level strings are keys
+          break;
+        case '{': case '[':
+          if (depth++ == 1) start = pos;
+          break;
+        case '}': case ']':
+          if (depth && --depth == 1 && key >= 0 && key < PRESET_INDEX_SIZE && !presetIndex.offset[key]) { // first occurrence wins (as with bufferedFind())
+            presetIndex.offset[key] = start;
+            presetIndex.length[key] = pos + 1 - start <= UINT16_MAX ? pos + 1 - start : 0;
+          }
+          break;
+      }
+    }
+  }
+  presetIndex.fileSize = file.size();
+  presetIndex.validate = cacheInvalidate;
+  presetIndex.valid    = true;
+  DEBUGFS_PRINTF("Preset index built, took %lu ms\n", millis() - s);
+  return true;
+}
+
+// keep index in sync with writeObjectToFile(), offset 0 removes entry
+static void updatePresetIndex(const char *fileName, const char *key, uint32_t offset, size_t len) {
+  if (!presetIndex.valid || !isPresetsFile(fileName)) return;
+  int id = atoi(key + 1); // key is "id":
+  if (id < 0 || id >= PRESET_INDEX_SIZE) return;
+  presetIndex.offset[id] = offset;
+  presetIndex.length[id] = len <= UINT16_MAX ? len : 0;
+  presetIndex.fileSize   = 0; // file size may have changed, adopt it on next lookup
+}
+
+// returns 1 if object was read, 0 if preset does not exist, -1 if index cannot be used
+static int readPresetUsingIndex(const char *fileName, uint16_t id, JsonDocument* dest, const JsonDocument* filter) {
+  #ifdef WLED_DEBUG_FS
+    uint32_t s = millis();
+  #endif
+  f = WLED_FS.open(fileName, "r");
+  if (!f) return -1;
+  if (!isPresetIndexCurrent(f.size()) && !buildPresetIndex(f)) { f.close(); return -1; }
+  const uint32_t offset = presetIndex.offset[id];
+  const uint16_t len    = presetIndex.length[id];
+  if (!offset) {
+    f.close();
+    dest->clear();
+    DEBUGFS_PRINTLN(F("Obj not found."));
+    return 0;
+  }
+  f.seek(offset);
+  if (f.peek() != '{') { // file was modified without us noticing
+    presetIndex.valid = false;
+    f.close();
+    return -1;
+  }
+  // read whole object at once, deserializing from a File stream fetches it byte by byte
+  char *obj = len ? static_cast<char*>(p_malloc(len)) : nullptr;
+  if (obj && f.read(reinterpret_cast<uint8_t*>(obj), len) == len) {
+    if (filter) deserializeJson(*dest, const_cast<const char*>(obj), len, DeserializationOption::Filter(*filter));
+    else        deserializeJson(*dest, const_cast<const char*>(obj), len);
+  } else {
+    f.seek(offset);
+    if (filter) deserializeJson(*dest, f, DeserializationOption::Filter(*filter));
+    else        deserializeJson(*dest, f);
+  }
+  p_free(obj);
+  f.close();
+  DEBUGFS_PRINTF("Read preset %u using index, took %lu ms\n", id, millis() - s);
+  return 1;
+}
+
+static bool appendObjectToFile(const char* file, const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0)
 {
   #ifdef WLED_DEBUG_FS
     DEBUGFS_PRINTLN(F("Append"));
@@ -203,6 +331,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
     f.print(key);
+    updatePresetIndex(file, key, f.position(), contentLen);
     serializeJson(*content, f);
     DEBUGFS_PRINTF("Inserted, took %lu ms (total %lu)", millis() - s1, millis() - s);
     doCloseFile = true;
@@ -243,9 +372,11 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   } else { //file content is not valid JSON object
     f.seek(0, SeekSet);
     f.print('{'); //start JSON
+    presetIndex.valid = false;
   }
 
   f.print(key);
+  updatePresetIndex(file, key, f.position(), contentLen);
 
   //Append object
   serializeJson(*content, f);
@@ -281,10 +412,11 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     DEBUGFS_PRINTLN(F("Failed to open!"));
     return false;
   }
+  if (isPresetsFile(fileName) && !isPresetIndexCurrent(f.size())) presetIndex.valid = false; // index is for a different file version, do not patch it
 
   if (!bufferedFind(key)) //key does not exist in file
   {
-    return appendObjectToFile(key, content, s);
+    return appendObjectToFile(fileName, key, content, s);
   }
 
   //an object with this key already exists, replace or delete it
@@ -310,17 +442,20 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     f.seek(pos);
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
+    updatePresetIndex(fileName, key, pos, contentLen);
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
     serializeJson(*content, f);
+    updatePresetIndex(fileName, key, pos, contentLen);
   } else {
     DEBUGFS_PRINTLN(F("delete"));
+    updatePresetIndex(fileName, key, 0, 0);
     pos -= strlen(key);
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
-    if (contentLen) return appendObjectToFile(key, content, s, contentLen);
+    if (contentLen) return appendObjectToFile(fileName, key, content, s, contentLen);
   }
 
   doCloseFile = true;
@@ -330,6 +465,14 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
 
 bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter)
 {
+  if (id < PRESET_INDEX_SIZE) {
+    char fileName[129]; strncpy_P(fileName, file, 128); fileName[128] = 0; //use PROGMEM safe copy as FS.open() does not
+    if (isPresetsFile(fileName)) {
+      if (doCloseFile) closeFile();
+      int found = readPresetUsingIndex(fileName, id, dest, filter);
+      if (found >= 0) return found;
+    }
+  }
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
   return readObjectFromFile(file, objKey, dest, filter);
@@ -0,0 +1,24 @@
+#pragma once
+#ifndef WLED_FIXED_POINT_H
+#define WLED_FIXED_POINT_H
+#include <stdint.h>
+
+// Q16.16 fixed point (16 integer, 16 fractional bits) for effect inner loops, avoids software float on MCUs without FPU (ESP8266, C3, S2)
+// range is +/-32767, convert floats once per frame (not per pixel)
+// (float math helpers are in wled_math.cpp)
+typedef int32_t q16_t;
+#define Q16_ONE 0x10000
+
+inline q16_t q16_from_float(float f) { return q16_t(f * Q16_ONE); }
+inline int   q16_to_int(q16_t a)     { return a < 0 ? -(-a >> 16) : a >> 16; } // truncates towards zero like a float to int cast
+inline q16_t q16_mul(q16_t a, q16_t b) { return q16_t((int64_t(a) * b) >> 16); }
+
+// complex square z = z^2 for z = a+ib, returns |z|^2 of the input (used for escape test of fractals)
+inline q16_t q16_csquare(q16_t &a, q16_t &b) {
+  const q16_t aa = q16_mul(a, a), bb = q16_mul(b, b);
+  b = q16_mul(a, b) * 2;
+  a = aa - bb;
+  return aa + bb;
+}
+
+#endif
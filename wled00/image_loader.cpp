@@ -1,14 +1,39 @@
 #include "wled.h"
 
-#ifdef WLED_ENABLE_GIF
+#if defined(WLED_ENABLE_GIF) || defined(WLED_ENABLE_FSEQ)
 
+#ifdef WLED_ENABLE_GIF
 #include "GifDecoder.h"
-
+#endif
 
 /*
  * Functions to render images from filesystem to segments, used by the "Image" effect
  */
 
+#define IMAGE_ERROR_NONE 0
+#define IMAGE_ERROR_NO_NAME 1
+#define IMAGE_ERROR_SEG_LIMIT 2
+#define IMAGE_ERROR_UNSUPPORTED_FORMAT 3
+#define IMAGE_ERROR_FILE_MISSING 4
+#define IMAGE_ERROR_DECODER_ALLOC 5
+#define IMAGE_ERROR_GIF_DECODE 6
+#define IMAGE_ERROR_FRAME_DECODE 7
+#define IMAGE_ERROR_WAITING 254
+#define IMAGE_ERROR_PREV 255
+
+#define IMAGE_ERROR_FSEQ_HEADER 8
+
+#ifdef WLED_ENABLE_FSEQ
+static bool hasExtension(const char *name, const char *ext) {
+  size_t len = strlen(name), extLen = strlen(ext);
+  return len > extLen && strcasecmp(name + len - extLen, ext) == 0;
+}
+
+static byte renderFseqToSegment(Segment &seg);
+static void endFseqPlayback(Segment *seg);
+#endif
+
+#ifdef WLED_ENABLE_GIF
 static File file;
 static char lastFilename[WLED_MAX_SEGNAME_LEN+2] = "/"; // enough space for "/" + seg.name + '\0'
 static GifDecoder<320,320,12,true> decoder;  // this creates the basic object; parameter lzwMaxBits is not used; decoder.alloc() always allocated "everything else" = 24Kb 
@@ -100,26 +125,46 @@ void drawPixelCallback2D(int16_t x, int16_t y, uint8_t red, uint8_t green, uint8
   }
 }
 
-#define IMAGE_ERROR_NONE 0
-#define IMAGE_ERROR_NO_NAME 1
-#define IMAGE_ERROR_SEG_LIMIT 2
-#define IMAGE_ERROR_UNSUPPORTED_FORMAT 3
-#define IMAGE_ERROR_FILE_MISSING 4
-#define IMAGE_ERROR_DECODER_ALLOC 5
-#define IMAGE_ERROR_GIF_DECODE 6
-#define IMAGE_ERROR_FRAME_DECODE 7
-#define IMAGE_ERROR_WAITING 254
-#define IMAGE_ERROR_PREV 255
+static byte renderGifToSegment(Segment &seg);
+static void endGifPlayback(Segment *seg);
+#endif
 
-// renders an image (.gif only; .bmp and .fseq to be added soon) from FS to a segment
+// renders an image (.gif) or pre-rendered sequence (.fseq) from FS to a segment
 byte renderImageToSegment(Segment &seg) {
   if (!seg.name) return IMAGE_ERROR_NO_NAME;
+  #ifdef WLED_ENABLE_FSEQ
+  if (hasExtension(seg.name, ".fseq")) {
+    #ifdef WLED_ENABLE_GIF
+    endGifPlayback(&seg); // segment may have been playing a GIF before
+    #endif
+    return renderFseqToSegment(seg);
+  }
+  endFseqPlayback(&seg);
+  #endif
+  #ifdef WLED_ENABLE_GIF
+  return renderGifToSegment(seg);
+  #else
+  return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+  #endif
+}
+
+void endImagePlayback(Segment *seg) {
+  #ifdef WLED_ENABLE_FSEQ
+  endFseqPlayback(seg);
+  #endif
+  #ifdef WLED_ENABLE_GIF
+  endGifPlayback(seg);
+  #endif
+}
+
+#ifdef WLED_ENABLE_GIF
+static byte renderGifToSegment(Segment &seg) {
   // disable during effect transition, causes flickering, multiple allocations and depending on image, part of old FX remaining
   //if (seg.mode != seg.currentMode()) return IMAGE_ERROR_WAITING;
   if (activeSeg && activeSeg != &seg) {            // only one segment at a time
     if (!seg.isActive()) return IMAGE_ERROR_SEG_LIMIT; // sanity check: calling segment must be active
     if (gifDecodeFailed || !activeSeg->isActive())     // decoder failed, or last segment became inactive
-      endImagePlayback(activeSeg);                     // => allow takeover but clean up first
+      endGifPlayback(activeSeg);                       // => allow takeover but clean up first
     else
       return IMAGE_ERROR_SEG_LIMIT;                
   }
@@ -226,9 +271,9 @@ byte renderImageToSegment(Segment &seg) {
   return IMAGE_ERROR_NONE;
 }
 
-void endImagePlayback(Segment *seg) {
-  DEBUG_PRINTLN(F("Image playback end called"));
+static void endGifPlayback(Segment *seg) {
   if (!activeSeg || activeSeg != seg) return;
+  DEBUG_PRINTLN(F("Image playback end called"));
   if (file) file.close();
   decoder.dealloc();
   gifDecodeFailed = false;
@@ -237,5 +282,290 @@ void endImagePlayback(Segment *seg) {
   gifWidth = gifHeight = 0;   // reset dimensions
   DEBUG_PRINTLN(F("Image playback ended"));
 }
+#endif // WLED_ENABLE_GIF
+
+#ifdef WLED_ENABLE_FSEQ
+/*
+ * FSEQ (v2) sequence player, plays pre-rendered shows (i.e. exported by xLights) from LittleFS or SD card (sd_card usermod)
+ * Only uncompressed sequences are supported (export with compression "None"), sparse ranges are honoured.
+ * Channels are mapped 3 per pixel (RGB) starting at the first (sparse) channel; only the channels covering
+ * the segment are read from storage. Frames are double buffered: the next frame is read while the current
+ * one is drawn (on ESP32 by a separate reader task), frames that can't be read in time are skipped and counted.
+ */
+
+#if defined(WLED_USE_SD_MMC)
+  #include "SD_MMC.h"
+  #define FSEQ_SD SD_MMC
+#elif defined(WLED_USE_SD_SPI)
+  #include "SD.h"
+  #define FSEQ_SD SD
+#endif
+#ifdef FSEQ_SD
+bool file_onSD(const char *filepath); // sd_card usermod
+#endif
+
+#define FSEQ_HEADER_SIZE 32
+#define FSEQ_MAX_RANGES  16
+
+struct FseqRead {
+  uint32_t src;  // offset within stored frame
+  uint32_t dst;  // offset within frame buffer (channel relative to first channel)
+  uint32_t len;
+};
+
+static struct {
+  File      file;
+  Segment  *seg;
+  char      name[WLED_MAX_SEGNAME_LEN+2];   // "/" + seg.name + '\0'
+  unsigned  pixels;                         // segment size the buffers were allocated for
+  uint8_t  *buffer[2];                      // front/back frame buffer (pixels * 3 bytes each)
+  volatile int32_t bufferFrame[2];          // frame held in buffer, -1 if empty or being read
+  FseqRead  reads[FSEQ_MAX_RANGES];
+  unsigned  numReads;
+  uint32_t  dataOffset;                     // file offset of frame 0
+  uint32_t  frameSize;                      // bytes per stored frame
+  uint32_t  frameCount;
+  uint32_t  frame;                          // frame expected in buffer[slot]
+  uint32_t  nextFrameTime;
+  uint32_t  dropped;
+  uint8_t   stepTime;                       // ms per frame
+  uint8_t   slot;
+  bool      failed;
+  volatile bool readError;
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t  reader;
+  volatile bool readerBusy;
+  volatile bool stopReader;
+  uint32_t      requestFrame;
+  uint8_t       requestSlot;
+#endif
+} fseq;
+
+static inline uint32_t fseqU32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static inline uint32_t fseqU24(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16); }
 
-#endif
\ No newline at end of file
+static void fseqReadFrame(uint32_t frame, unsigned slot) {
+  uint8_t *buf = fseq.buffer[slot];
+  uint32_t base = fseq.dataOffset + frame * fseq.frameSize;
+  for (unsigned r = 0; r < fseq.numReads; r++) {
+    const FseqRead &rd = fseq.reads[r];
+    if (!fseq.file.seek(base + rd.src) || fseq.file.read(buf + rd.dst, rd.len) != rd.len) {
+      fseq.readError = true;
+      return;
+    }
+  }
+  fseq.bufferFrame[slot] = frame;
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+static void fseqReaderTask(void *) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (fseq.stopReader) break;
+    fseqReadFrame(fseq.requestFrame, fseq.requestSlot);
+    fseq.readerBusy = false;
+  }
+  fseq.reader = nullptr;
+  vTaskDelete(nullptr);
+}
+
+static inline bool fseqReaderBusy() { return fseq.readerBusy; }
+#else
+static inline bool fseqReaderBusy() { return false; }
+#endif
+
+// read frame into buffer slot, asynchronously if reader task is running
+static void fseqRequestFrame(uint32_t frame, unsigned slot) {
+  fseq.bufferFrame[slot] = -1;
+  #ifdef ARDUINO_ARCH_ESP32
+  if (fseq.reader) {
+    fseq.requestFrame = frame;
+    fseq.requestSlot  = slot;
+    fseq.readerBusy   = true;
+    xTaskNotifyGive(fseq.reader);
+    return;
+  }
+  #endif
+  fseqReadFrame(frame, slot);
+}
+
+// release file, buffers and reader task but keep segment and file name (so a failed file is not retried every frame)
+static void fseqCleanup() {
+  #ifdef ARDUINO_ARCH_ESP32
+  if (fseq.reader) {
+    fseq.stopReader = true;
+    xTaskNotifyGive(fseq.reader);
+    while (fseq.reader) delay(1); // reader finishes pending read first
+    fseq.stopReader = false;
+  }
+  fseq.readerBusy = false;
+  #endif
+  if (fseq.file) fseq.file.close();
+  p_free(fseq.buffer[0]);
+  fseq.buffer[0] = fseq.buffer[1] = nullptr;
+  fseq.bufferFrame[0] = fseq.bufferFrame[1] = -1;
+}
+
+static File openSequence(const char *filename) {
+  #ifdef FSEQ_SD
+  if (file_onSD(filename)) return FSEQ_SD.open(filename, "r");
+  #endif
+  return WLED_FS.open(filename, "r");
+}
+
+static byte openFseq() {
+  fseq.file = openSequence(fseq.name);
+  DEBUG_PRINTF_P(PSTR("opening FSEQ file %s\n"), fseq.name);
+  if (!fseq.file) return IMAGE_ERROR_FILE_MISSING;
+
+  uint8_t hdr[FSEQ_HEADER_SIZE];
+  if (fseq.file.read(hdr, FSEQ_HEADER_SIZE) != FSEQ_HEADER_SIZE || memcmp(hdr, "PSEQ", 4) != 0) return IMAGE_ERROR_FSEQ_HEADER;
+  if (hdr[7] != 2) {
+    DEBUG_PRINTF_P(PSTR("FSEQ v%u not supported\n"), hdr[7]);
+    return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+  }
+  if (hdr[20] & 0x0F) {
+    DEBUG_PRINTLN(F("FSEQ compression not supported"));
+    return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+  }
+  fseq.dataOffset = hdr[4] | (hdr[5] << 8);
+  fseq.frameSize  = fseqU32(hdr + 10);
+  fseq.frameCount = fseqU32(hdr + 14);
+  fseq.stepTime   = hdr[18];
+  unsigned compBlocks = ((hdr[20] & 0xF0) << 4) | hdr[21];
+  unsigned numRanges  = hdr[22];
+  if (fseq.frameSize == 0 || fseq.stepTime == 0 || fseq.dataOffset < FSEQ_HEADER_SIZE) return IMAGE_ERROR_FSEQ_HEADER;
+  if (fseq.file.size() > fseq.dataOffset) {
+    uint32_t available = (fseq.file.size() - fseq.dataOffset) / fseq.frameSize; // truncated file: play what is there
+    if (available < fseq.frameCount) fseq.frameCount = available;
+  } else fseq.frameCount = 0;
+  if (fseq.frameCount == 0) return IMAGE_ERROR_FSEQ_HEADER;
+  if (numRanges > FSEQ_MAX_RANGES) return IMAGE_ERROR_UNSUPPORTED_FORMAT;
+
+  // build list of reads covering the segment
+  uint32_t wanted = fseq.pixels * 3;
+  fseq.numReads = 0;
+  if (numRanges == 0) {
+    fseq.reads[0] = { 0, 0, min(fseq.frameSize, wanted) };
+    fseq.numReads = 1;
+  } else {
+    uint8_t ranges[FSEQ_MAX_RANGES * 6];
+    size_t rangesSize = numRanges * 6;
+    if (!fseq.file.seek(FSEQ_HEADER_SIZE + compBlocks * 8) || fseq.file.read(ranges, rangesSize) != rangesSize) return IMAGE_ERROR_FSEQ_HEADER;
+    uint32_t first = UINT32_MAX;
+    for (unsigned r = 0; r < numRanges; r++) first = min(first, fseqU24(ranges + r*6));
+    uint32_t src = 0; // sparse ranges are stored back to back in each frame
+    for (unsigned r = 0; r < numRanges; r++) {
+      uint32_t dst   = fseqU24(ranges + r*6) - first;
+      uint32_t count = fseqU24(ranges + r*6 + 3);
+      if (src + count > fseq.frameSize) count = src < fseq.frameSize ? fseq.frameSize - src : 0; // inconsistent header
+      if (dst < wanted && count) fseq.reads[fseq.numReads++] = { src, dst, min(count, wanted - dst) };
+      src += count;
+    }
+  }
+
+  fseq.buffer[0] = static_cast<uint8_t*>(p_calloc(2, wanted)); // gaps between sparse ranges stay black
+  if (!fseq.buffer[0]) {
+    errorFlag = ERR_NORAM_PX;
+    return IMAGE_ERROR_DECODER_ALLOC;
+  }
+  fseq.buffer[1] = fseq.buffer[0] + wanted;
+  fseq.readError = false;
+  fseq.dropped   = 0;
+  fseq.frame     = 0;
+  fseq.slot      = 0;
+
+  #ifdef ARDUINO_ARCH_ESP32
+  // read-ahead task, fall back to reading in loop() if it can't be created
+  if (xTaskCreatePinnedToCore(fseqReaderTask, "FSEQ_READ", 4096, nullptr, 1, &fseq.reader, 0) != pdPASS) fseq.reader = nullptr;
+  #endif
+  fseqRequestFrame(0, 0);
+  fseq.nextFrameTime = millis();
+  DEBUG_PRINTF_P(PSTR("FSEQ: %u frames @ %ums, %u channels, %u ranges\n"), fseq.frameCount, fseq.stepTime, fseq.frameSize, numRanges);
+  return IMAGE_ERROR_NONE;
+}
+
+static byte renderFseqToSegment(Segment &seg) {
+  if (fseq.seg && fseq.seg != &seg) {                  // only one segment at a time
+    if (!seg.isActive()) return IMAGE_ERROR_SEG_LIMIT; // sanity check: calling segment must be active
+    if (fseq.failed || !fseq.seg->isActive())          // playback failed, or last segment became inactive
+      endFseqPlayback(fseq.seg);                       // => allow takeover but clean up first
+    else
+      return IMAGE_ERROR_SEG_LIMIT;
+  }
+
+  unsigned pixels = seg.is2D() ? seg.vWidth() * seg.vHeight() : seg.vLength();
+  if (!fseq.seg || strncmp(fseq.name +1, seg.name, WLED_MAX_SEGNAME_LEN) != 0 || fseq.pixels != pixels) { // new file or segment resized
+    fseqCleanup();
+    fseq.seg = &seg;
+    fseq.pixels = pixels;
+    strcpy(fseq.name, "/");  // filename always starts with '/'
+    strncpy(fseq.name +1, seg.name, WLED_MAX_SEGNAME_LEN);
+    fseq.name[WLED_MAX_SEGNAME_LEN+1] = '\0';
+    byte result = openFseq();
+    fseq.failed = (result != IMAGE_ERROR_NONE);
+    if (fseq.failed) {
+      DEBUG_PRINTF_P(PSTR("FSEQ playback error %u: %s\n"), result, fseq.name);
+      fseqCleanup();
+      return result;
+    }
+  }
+  if (fseq.failed) return IMAGE_ERROR_PREV;
+
+  // speed 0 = half speed, 128 = normal, 255 = full FX FPS (same as GIF)
+  uint32_t wait = fseq.stepTime * 2 - seg.speed * fseq.stepTime / 128;
+  if (wait == 0) wait = 1;
+  uint32_t now = millis();
+  if ((int32_t)(now - fseq.nextFrameTime) < 0) return IMAGE_ERROR_WAITING;
+  if (fseq.readError) {
+    fseq.failed = true;
+    fseqCleanup();
+    return IMAGE_ERROR_FRAME_DECODE;
+  }
+  if (fseqReaderBusy() || fseq.bufferFrame[fseq.slot] != (int32_t)fseq.frame) return IMAGE_ERROR_WAITING; // storage too slow, skipped below
+
+  // frames that should have been shown in the meantime are skipped
+  uint32_t late = (now - fseq.nextFrameTime) / wait;
+  if (late >= fseq.frameCount) { // playback was paused (i.e. segment off), not dropped
+    late = 0;
+    fseq.nextFrameTime = now;
+  }
+  fseq.dropped += late;
+  fseq.nextFrameTime += wait * (late + 1);
+
+  // start reading next frame into back buffer before drawing the front buffer
+  const uint8_t *buf = fseq.buffer[fseq.slot];
+  fseq.slot ^= 1;
+  fseq.frame = (fseq.frame + late + 1) % fseq.frameCount;
+  fseqRequestFrame(fseq.frame, fseq.slot);
+
+  if (seg.is2D()) {
+    unsigned w = seg.vWidth(), h = seg.vHeight();
+    for (unsigned y = 0; y < h; y++)
+      for (unsigned x = 0; x < w; x++, buf += 3) seg.setPixelColorXY(x, y, RGBW32(buf[0], buf[1], buf[2], 0));
+  } else {
+    for (unsigned i = 0; i < pixels; i++, buf += 3) seg.setPixelColor(i, RGBW32(buf[0], buf[1], buf[2], 0));
+  }
+  return IMAGE_ERROR_NONE;
+}
+
+static void endFseqPlayback(Segment *seg) {
+  if (!fseq.seg || fseq.seg != seg) return;
+  fseqCleanup();
+  fseq.seg = nullptr;
+  fseq.failed = false;
+  strcpy(fseq.name, "/");
+  DEBUG_PRINTLN(F("FSEQ playback ended"));
+}
+
+// current frame, total frames and number of skipped frames of the running sequence
+bool getFseqPlaybackStats(uint32_t &frame, uint32_t &frames, uint32_t &dropped) {
+  if (!fseq.seg || fseq.failed) return false;
+  frame   = fseq.frame;
+  frames  = fseq.frameCount;
+  dropped = fseq.dropped;
+  return true;
+}
+#endif // WLED_ENABLE_FSEQ
+
+#endif
@@ -501,6 +501,16 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
 
   loadLedmap = root[F("ledmap")] | loadLedmap;
 
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  JsonObject bench = root[F("fxbench")];
+  if (!bench.isNull()) { // will be executed in loop() context, results in /fxbench.csv
+    fxBenchHeight = bench["h"] | 1;
+    fxBenchFrames = bench["n"] | 100;
+    fxBenchMode   = bench[F("fx")] | 255;
+    fxBenchWidth  = bench["w"] | strip.getLengthTotal(); // set last, used as request flag
+  }
+  #endif
+
   byte ps = root[F("psave")];
   if (ps > 0 && ps < 251) savePreset(ps, nullptr, root);
 
@@ -598,7 +608,7 @@ static void serializeSegment(JsonObject& root, const Segment& seg, byte id, bool
   root[F("set")] = seg.set;
   root["lc"]     = seg.getLightCapabilities();
 
-  if (seg.name != nullptr) root["n"] = reinterpret_cast<const char *>(seg.name); //not good practice, but decreases required JSON buffer
+  if (seg.name != nullptr) root["n"] = seg.name; // copied: responses are sent after the state lock is released (segment may be renamed meanwhile)
   else if (forPreset) root["n"] = "";
 
   // to conserve RAM we will serialize the col array manually
@@ -723,6 +733,30 @@ void serializeInfo(JsonObject root)
   leds[F("count")] = strip.getLengthTotal();
   leds[F("pwr")] = BusManager::currentMilliamps();
   leds["fps"] = strip.getFps();
+  leds[F("skipseg")] = strip.getSkippedSegments(); // segments not re-blended in last frame (unchanged)
+  leds[F("skippx")] = strip.getSkippedPixels();
+  leds[F("fxus")] = strip.getEffectTime();   // average effect time per frame (us)
+  leds[F("ovlus")] = strip.getOverlapTime(); // part of effect time overlapping bus transmission (us)
+  leds[F("mapms")] = strip.getLedmapLoadTime();   // time to load last ledmap (ms)
+  leds[F("mapheap")] = strip.getLedmapLoadHeap(); // peak heap used while loading last ledmap (B)
+  #ifdef WLED_SEGMENT_ARENA
+  JsonObject arena = leds.createNestedObject(F("arena")); // effect data arena
+  arena[F("size")] = Segment::getDataArenaSize();
+  arena[F("used")] = Segment::getUsedSegmentData();
+  arena[F("lfb")]  = Segment::getDataArenaLargestFree();
+  arena[F("frag")] = Segment::getDataArenaFragmentation(); // %
+  arena[F("fail")] = Segment::getDataArenaFailures();
+  arena[F("cmp")]  = Segment::getDataArenaCompactions();
+  #endif
+  #ifdef WLED_ENABLE_FSEQ
+  uint32_t fseqFrame, fseqFrames, fseqDropped;
+  if (getFseqPlaybackStats(fseqFrame, fseqFrames, fseqDropped)) {
+    JsonObject fseq = leds.createNestedObject(F("fseq")); // running FSEQ sequence
+    fseq[F("frame")]  = fseqFrame;
+    fseq[F("frames")] = fseqFrames;
+    fseq[F("drop")]   = fseqDropped;
+  }
+  #endif
   leds[F("maxpwr")] = BusManager::currentMilliamps()>0 ? BusManager::ablMilliampsMax() : 0;
   leds[F("maxseg")] = WS2812FX::getMaxSegments();
   //leds[F("actseg")] = strip.getActiveSegmentsNum();
@@ -785,6 +819,10 @@ void serializeInfo(JsonObject root)
   }
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
+  root[F("lpps")] = realtimeMode ? realtimePacketsPerSec : 0; // realtime packets per second
+  root[F("lus")]  = realtimeMode ? realtimeUsPerPacket : 0;   // average processing time per realtime packet (us)
+  root[F("llate")] = realtimeMode ? e131LatePerSec : 0;       // out-of-sequence E1.31/Art-Net packets per second
+  root[F("ldrop")] = realtimeMode ? e131DroppedPerSec : 0;    // universes missing from shown frames per second
 
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
@@ -888,6 +926,31 @@ void serializeInfo(JsonObject root)
   #endif
   root[F("uptime")] = millis()/1000 + rolloverMillis*4294967;
 
+  JSONPoolStats jp = getJSONPoolStats();
+  JsonObject jpool = root.createNestedObject(F("jpool")); // JSON document pool
+  jpool[F("size")]  = WLED_JSON_POOL_SIZE;
+  jpool[F("used")]  = jp.inUse;
+  jpool[F("peak")]  = jp.peak;
+  jpool[F("acq")]   = jp.acquired;
+  jpool[F("wait")]  = jp.waited;
+  jpool[F("waitms")] = jp.waitMs;
+  jpool[F("maxms")] = jp.maxWaitMs;
+  jpool[F("fail")]  = jp.failed;
+  jpool[F("defer")] = jp.deferred;
+  JsonArray owners = jpool.createNestedArray(F("own")); // JSON_LOCK_* module holding each document (pDoc first), 0 = free
+  for (size_t i = 0; i < WLED_JSON_POOL_SIZE; i++) owners.add(jp.owner[i]);
+  JsonArray locks = jpool.createNestedArray(F("lock")); // global JSON lock per owner: [JSON_LOCK_* (0 = other), locks, wait ms, max ms, failed]
+  const JSONLockWait *lw = getJSONLockWaits();
+  for (size_t i = 0; i < JSON_LOCK_IDS; i++) {
+    if (!lw[i].locks && !lw[i].failed) continue;
+    JsonArray l = locks.createNestedArray();
+    l.add(i);
+    l.add(lw[i].locks);
+    l.add(lw[i].waitMs);
+    l.add(lw[i].maxWaitMs);
+    l.add(lw[i].failed);
+  }
+
   char time[32];
   getTimeString(time);
   root[F("time")] = time;
@@ -1321,34 +1384,42 @@ void respondModeData(AsyncWebServerRequest* request) {
   });
 }
 
-// Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
+// Pool document response helper class (to make sure document is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
-  bool _holding_lock;
+  JsonDocument *_doc;
   public:
-  // WARNING: constructor assumes requestJSONBufferLock() was successfully acquired externally/prior to constructing the instance
+  // WARNING: constructor assumes doc was successfully acquired (acquireJSONDocument()) prior to constructing the instance
   // Not a good practice with C++. Unfortunately AsyncJsonResponse only has 2 constructors - for dynamic buffer or existing buffer,
   // with existing buffer it clears its content during construction
-  // if the lock was not acquired (using JSONBufferGuard class) previous implementation still cleared existing buffer
-  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _holding_lock(true) {};
+  inline LockedJsonResponse(JsonDocument* doc, bool isArray) : AsyncJsonResponse(doc, isArray), _doc(doc) {};
 
   virtual size_t _fillBuffer(uint8_t *buf, size_t maxLen) { 
     size_t result = AsyncJsonResponse::_fillBuffer(buf, maxLen);
-    // Release lock as soon as we're done filling content
-    if (((result + _sentLength) >= (_contentLength)) && _holding_lock) {
-      releaseJSONBufferLock();
-      _holding_lock = false;
+    // Release document as soon as we're done filling content
+    if (((result + _sentLength) >= (_contentLength)) && _doc) {
+      releaseJSONDocument(_doc);
+      _doc = nullptr;
     }
     return result;
   }
 
-  // destructor will remove JSON buffer lock when response is destroyed in AsyncWebServer
-  virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
+  // destructor will release document when response is destroyed in AsyncWebServer
+  virtual ~LockedJsonResponse() { releaseJSONDocument(_doc); };
 };
 
+// timing statistics, too large for /json/info (which is also pushed to every websocket client)
+static void serializeProfiling(JsonObject root)
+{
+  #ifndef WLED_DISABLE_FX_PROFILE
+  strip.serializeProfile(root); // per segment effect and blend times
+  #endif
+  LoopScheduler::serializeStats(root); // main loop and per task runtime
+}
+
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, networks, config, pins
+    all, state, info, state_info, nodes, effects, palettes, networks, config, pins, profile
   };
   json_target subJson = json_target::all;
 
@@ -1363,6 +1434,7 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
   else if (url.indexOf(F("pins"))  > 0) subJson = json_target::pins;
+  else if (url.indexOf(F("prof"))  > 0) subJson = json_target::profile;
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1378,13 +1450,16 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
-  if (!requestJSONBufferLock(JSON_LOCK_SERVEJSON)) {
-    request->deferResponse();    
+  JsonDocument *doc = acquireJSONDocument(JSON_LOCK_SERVEJSON);
+  if (!doc || !lockJSONState(JSON_LOCK_SERVEJSON)) {
+    releaseJSONDocument(doc);
+    countJSONDeferral();
+    request->deferResponse();
     return;
   }
-  // releaseJSONBufferLock() will be called when "response" is destroyed (from AsyncWebServer)
+  // releaseJSONDocument() will be called when "response" is destroyed (from AsyncWebServer)
   // make sure you delete "response" if no "request->send(response);" is made
-  LockedJsonResponse *response = new LockedJsonResponse(pDoc, subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
+  LockedJsonResponse *response = new LockedJsonResponse(doc, subJson==json_target::effects); // will clear and convert JsonDocument into JsonArray if necessary
 
   JsonVariant lDoc = response->getRoot();
 
@@ -1406,6 +1481,8 @@ void serveJson(AsyncWebServerRequest* request)
       serializeConfig(lDoc); break;
     case json_target::pins:
       serializePins(lDoc); break;
+    case json_target::profile:
+      serializeProfiling(lDoc); break;
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
@@ -1425,6 +1502,7 @@ void serveJson(AsyncWebServerRequest* request)
 
   [[maybe_unused]] size_t len = response->setLength();
   DEBUG_PRINTF_P(PSTR("JSON content length: %u\n"), len);
+  unlockJSONState(); // state is copied into document, it is sent without holding up others
 
   request->send(response);
 }
@@ -1458,6 +1536,7 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
   char* buf = buffer.data();      // assign buffer for oappnd() functions
   strncpy_P(buffer.data(), PSTR("{\"leds\":["), buffer.size());
   buf += 9; // sizeof(PSTR()) from last line
+  const char hex[] = "0123456789ABCDEF";
 
   for (size_t i = 0; i < used; i += n)
   {
@@ -1472,7 +1551,12 @@ bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient)
     r = scale8(qadd8(w, r), strip.getBrightness()); //R, add white channel to RGB channels as a simple RGBW -> RGB map
     g = scale8(qadd8(w, g), strip.getBrightness()); //G
     b = scale8(qadd8(w, b), strip.getBrightness()); //B
-    buf += sprintf_P(buf, PSTR("\"%06X\","), RGBW32(r,g,b,0));
+    // "RRGGBB", formatted by hand as sprintf() dominates for large LED counts
+    const uint8_t rgb[3] = {r, g, b};
+    *buf++ = '"';
+    for (uint8_t v : rgb) { *buf++ = hex[v >> 4]; *buf++ = hex[v & 0x0F]; }
+    *buf++ = '"';
+    *buf++ = ',';
   }
   buf--;  // remove last comma
   buf += sprintf_P(buf, PSTR("],\"n\":%d"), n);
@@ -0,0 +1,152 @@
+#include "wled.h"
+
+/*
+ * Cooperative scheduler for WLED::loop() subsystems, see loop_scheduler.h
+ */
+
+LoopTask      LoopScheduler::_tasks[WLED_MAX_LOOP_TASKS];
+uint8_t       LoopScheduler::_numTasks = 0;
+int8_t        LoopScheduler::_frameTask = -1;
+unsigned    (*LoopScheduler::_msToFrame)() = nullptr;
+unsigned long LoopScheduler::_windowStart = 0;
+uint32_t      LoopScheduler::_loops = 0;
+uint32_t      LoopScheduler::_loopUs = 0;
+uint32_t      LoopScheduler::_loopMaxUs = 0;
+uint32_t      LoopScheduler::_lastLoops = 0;
+uint32_t      LoopScheduler::_lastLoopUs = 0;
+uint32_t      LoopScheduler::_lastLoopMaxUs = 0;
+uint32_t      LoopScheduler::_lastWindow = 0;
+uint32_t      LoopScheduler::_frames = 0;
+
+bool LoopScheduler::addTask(const char *name, LoopTaskFn fn, uint16_t period, uint16_t budget, LoopPriority priority) {
+  if (!fn || _numTasks >= WLED_MAX_LOOP_TASKS) {
+    DEBUG_PRINTF_P(PSTR("Loop task %u not added!\n"), _numTasks);
+    return false;
+  }
+  if (priority == LoopPriority::Frame) {
+    if (_frameTask >= 0) return false; // only one frame task
+    _frameTask = _numTasks;
+  }
+  LoopTask &task = _tasks[_numTasks++];
+  memset(&task, 0, sizeof(LoopTask));
+  task.name     = name;
+  task.fn       = fn;
+  task.period   = period;
+  task.budget   = budget;
+  task.priority = priority;
+  return true;
+}
+
+void LoopScheduler::runTask(LoopTask &task, unsigned long now) {
+  unsigned long t0 = micros();
+  task.fn();
+  uint32_t us = micros() - t0;
+  task.lastRun = now;
+  task.deferredSince = 0;
+  task.cur.runs++;
+  task.cur.totalUs += us;
+  if (us > task.cur.maxUs) task.cur.maxUs = us;
+  if (task.budget && us > task.budget * 1000U) task.cur.overruns++;
+}
+
+// runs frame task and counts the frame if one was rendered (it was due before and is not anymore)
+void LoopScheduler::runFrame(LoopTask &task, unsigned long now) {
+  const bool due = _msToFrame && _msToFrame() == 0;
+  runTask(task, now);
+  if (due && _msToFrame() > 0) _frames++;
+}
+
+void LoopScheduler::run() {
+  unsigned long loopStart = micros();
+  unsigned long now = millis();
+  bool frameDone = false;
+
+  for (unsigned i = 0; i < _numTasks; i++) {
+    LoopTask &task = _tasks[i];
+    if (task.priority == LoopPriority::Frame) {
+      if (!frameDone) runFrame(task, now);
+      frameDone = true;
+      now = millis();
+      continue;
+    }
+    if (task.period && now - task.lastRun < task.period) continue;
+
+    if (task.priority >= LoopPriority::Normal && _msToFrame) {
+      unsigned msToFrame = _msToFrame();
+      if (msToFrame == 0 && !frameDone && _frameTask >= 0) {
+        runFrame(_tasks[_frameTask], now); // frame is due: render it before deferrable work
+        frameDone = true;
+        now = millis();
+        msToFrame = _msToFrame();
+      }
+      unsigned budget = task.priority == LoopPriority::Low ? 2 * task.budget : task.budget;
+      // msToFrame is 0 after service() if it could not render (suspended, bus busy): no point in waiting then
+      if (msToFrame > 0 && budget > msToFrame) {
+        if (!task.deferredSince) {
+          task.deferredSince = now ? now : 1;
+          task.deferredFrame = _frames;
+        }
+        // waiting beyond the next frame does not help (budget may exceed frame time): run right after it
+        if (task.deferredFrame == _frames && now - task.deferredSince < WLED_LOOP_MAX_DEFER) {
+          task.cur.deferred++;
+          continue;
+        }
+      }
+    }
+
+    runTask(task, now);
+    if (task.priority >= LoopPriority::Normal) yield();
+    now = millis();
+  }
+
+  uint32_t us = micros() - loopStart;
+  _loops++;
+  _loopUs += us;
+  if (us > _loopMaxUs) _loopMaxUs = us;
+  if (now - _windowStart >= WLED_LOOP_STATS_WINDOW) rollStats(now);
+}
+
+void LoopScheduler::rollStats(unsigned long now) {
+  for (unsigned i = 0; i < _numTasks; i++) {
+    _tasks[i].last = _tasks[i].cur;
+    memset(&_tasks[i].cur, 0, sizeof(LoopTaskStats));
+  }
+  _lastLoops     = _loops;
+  _lastLoopUs    = _loopUs;
+  _lastLoopMaxUs = _loopMaxUs;
+  _lastWindow    = now - _windowStart;
+  _loops = _loopUs = _loopMaxUs = 0;
+  _windowStart = now;
+}
+
+// statistics of the last completed window: loops/s, average and max loop time (us) and per task runs, average/max time (us), deferrals and budget overruns
+void LoopScheduler::serializeStats(JsonObject root) {
+  JsonObject loop = root.createNestedObject(F("loop"));
+  loop[F("lps")] = _lastWindow ? (uint32_t)((uint64_t)_lastLoops * 1000 / _lastWindow) : 0;
+  loop[F("us")]  = _lastLoops ? _lastLoopUs / _lastLoops : 0;
+  loop[F("max")] = _lastLoopMaxUs;
+  JsonArray tasks = loop.createNestedArray(F("tasks"));
+  for (unsigned i = 0; i < _numTasks; i++) {
+    const LoopTask &task = _tasks[i];
+    JsonObject t = tasks.createNestedObject();
+    t["n"]    = FPSTR(task.name);
+    t["runs"] = task.last.runs;
+    t["us"]   = task.last.runs ? task.last.totalUs / task.last.runs : 0;
+    t["max"]  = task.last.maxUs;
+    t["def"]  = task.last.deferred;
+    t["over"] = task.last.overruns;
+  }
+}
+
+void LoopScheduler::printStats(Print &out) {
+  out.printf_P(PSTR("Loop: %u/s, %uus avg, %uus max\n"), _lastWindow ? (unsigned)((uint64_t)_lastLoops * 1000 / _lastWindow) : 0,
+    _lastLoops ? (unsigned)(_lastLoopUs / _lastLoops) : 0, (unsigned)_lastLoopMaxUs);
+  for (unsigned i = 0; i < _numTasks; i++) {
+    const LoopTask &task = _tasks[i];
+    out.print(' ');
+    out.print(FPSTR(task.name)); // name is in PROGMEM
+    out.printf_P(PSTR(": runs %u avg %uus max %uus def %u over %u\n"), (unsigned)task.last.runs,
+      task.last.runs ? (unsigned)(task.last.totalUs / task.last.runs) : 0, (unsigned)task.last.maxUs,
+      (unsigned)task.last.deferred, (unsigned)task.last.overruns);
+  }
+}
@@ -0,0 +1,78 @@
+#ifndef WLED_LOOP_SCHEDULER_H
+#define WLED_LOOP_SCHEDULER_H
+/*
+ * Cooperative scheduler for WLED::loop() subsystems
+ *
+ * Tasks run in registration order, each at most once per loop iteration and no more often than its period.
+ * The frame task (strip.service()) is run ahead of the remaining tasks as soon as its frame is due, and
+ * deferrable tasks are postponed if their time budget would make the next frame late. A postponed task runs
+ * right after the next rendered frame (when there is most time until the following one), so a budget larger
+ * than the frame time delays it by at most one frame.
+ */
+
+#ifndef WLED_MAX_LOOP_TASKS
+  #define WLED_MAX_LOOP_TASKS 24
+#endif
+#ifndef WLED_LOOP_MAX_DEFER
+  #define WLED_LOOP_MAX_DEFER 250   // ms a deferrable task may be postponed before it is run regardless of the next frame
+#endif
+#define WLED_LOOP_STATS_WINDOW 10000 // ms, statistics are reported for the last completed window
+
+enum struct LoopPriority : uint8_t {
+  Frame,  // strip.service(), runs every iteration and ahead of deferrable tasks once its frame is due
+  High,   // never deferred (network input, realtime, transitions)
+  Normal, // deferred if its budget does not fit before the next frame
+  Low     // deferred if twice its budget does not fit before the next frame
+};
+
+typedef void (*LoopTaskFn)();
+
+struct LoopTaskStats {
+  uint32_t runs;
+  uint32_t deferred;  // times postponed because a frame was due
+  uint32_t overruns;  // runs exceeding the budget
+  uint32_t totalUs;
+  uint32_t maxUs;
+};
+
+struct LoopTask {
+  const char   *name;       // PROGMEM
+  LoopTaskFn    fn;
+  uint16_t      period;     // ms between runs, 0 = every iteration
+  uint16_t      budget;     // ms the task is expected to take at most
+  LoopPriority  priority;
+  unsigned long lastRun;
+  unsigned long deferredSince;
+  uint32_t      deferredFrame; // frame counter when task was first postponed
+  LoopTaskStats cur;        // running window
+  LoopTaskStats last;       // last completed window
+};
+
+class LoopScheduler {
+  private:
+    static LoopTask      _tasks[WLED_MAX_LOOP_TASKS];
+    static uint8_t       _numTasks;
+    static int8_t        _frameTask;
+    static unsigned    (*_msToFrame)();
+    static unsigned long _windowStart;
+    static uint32_t      _loops, _loopUs, _loopMaxUs;          // running window
+    static uint32_t      _lastLoops, _lastLoopUs, _lastLoopMaxUs; // last completed window
+    static uint32_t      _lastWindow;                          // length of last completed window (ms)
+    static uint32_t      _frames;                              // frames rendered by frame task
+
+    static void runTask(LoopTask &task, unsigned long now);
+    static void runFrame(LoopTask &task, unsigned long now);
+    static void rollStats(unsigned long now);
+
+  public:
+    // returns false if the task table is full
+    static bool addTask(const char *name, LoopTaskFn fn, uint16_t period, uint16_t budget, LoopPriority priority);
+    // function returning ms until the frame task has to run (0 = due now)
+    static void setFrameDeadline(unsigned (*msToFrame)()) { _msToFrame = msToFrame; }
+    static void run(); // one loop iteration
+
+    static void serializeStats(JsonObject root);
+    static void printStats(Print &out);
+};
+
+#endif
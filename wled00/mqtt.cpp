@@ -113,17 +113,19 @@ static void onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProp
     colorFromDecOrHexString(colPri, payloadStr);
     colorUpdated(CALL_MODE_DIRECT_CHANGE);
   } else if (strcmp_P(topic, PSTR("/api")) == 0) {
-    if (requestJSONBufferLock(JSON_LOCK_MQTT)) {
+    JsonDocument *doc = acquireJSONDocument(JSON_LOCK_MQTT);
+    if (doc && lockJSONState(JSON_LOCK_MQTT)) {
       if (payloadStr[0] == '{') { //JSON API
-        deserializeJson(*pDoc, payloadStr);
-        deserializeState(pDoc->as<JsonObject>());
+        deserializeJson(*doc, payloadStr);
+        deserializeState(doc->as<JsonObject>());
       } else { //HTTP API
         String apireq = "win"; apireq += '&'; // reduce flash string usage
         apireq += payloadStr;
         handleSet(nullptr, apireq);
       }
-      releaseJSONBufferLock();
-    }
+      unlockJSONState();
+    } else countJSONDeferral();
+    releaseJSONDocument(doc);
   } else if (strlen(topic) != 0) {
     // non standard topic, check with usermods
     UsermodManager::onMqttMessage(topic, payloadStr);
@@ -1,3 +1,6 @@
+#pragma once
+#ifndef WLED_PRNG_H
+#define WLED_PRNG_H
 #include "wled.h"
 
 // Simple and fast Pseudo-Random-Number-Generator for 16bit and 8bit random numbers
@@ -21,3 +24,4 @@ public:
   uint8_t random8(uint8_t lim) { return (uint8_t)(((uint16_t)random8() * lim) >> 8); }
   uint8_t random8(uint8_t min, uint8_t lim) { uint8_t delta = lim - min; return random8(delta) + min; }
 };
+#endif
@@ -278,7 +278,7 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       }
       type |= request->hasArg(rf) << 7; // off refresh override
       driverType = request->arg(ld).toInt(); // 0=RMT (default), 1=I2S
-      text = request->arg(hs).substring(0,31);
+      text = request->arg(hs).substring(0,WLED_NET_HOSTS_MAXLEN);
       // actual finalization is done in WLED::loop() (removing old busses and adding new)
       // this may happen even before this loop is finished so we do "doInitBusses" after the loop
       busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, maPerLed, maMax, driverType, text);
@@ -471,6 +471,8 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     realtimeRespectLedMaps = request->hasArg(F("RLM"));
     e131SkipOutOfSequence = request->hasArg(F("ES"));
     e131Multicast = request->hasArg(F("EM"));
+    t = request->arg(F("FD")).toInt();
+    if (t >= 0 && t <= 250) e131FrameTimeout = t;
     t = request->arg(F("EP")).toInt();
     if (t > 0) e131Port = t;
     t = request->arg(F("EU")).toInt();
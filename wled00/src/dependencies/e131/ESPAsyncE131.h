@@ -77,6 +77,12 @@ typedef struct ip_addr ip4_addr_t;
 #define ARTNET_OPCODE_OPDMX 0x5000
 #define ARTNET_OPCODE_OPPOLL 0x2000
 #define ARTNET_OPCODE_OPPOLLREPLY 0x2100
+#define ARTNET_OPCODE_OPSYNC 0x5200
+
+// E1.31 synchronization packet (E1.31-2016 6.3), shares root layer and frame vector offset with data packet
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+#define E131_VECTOR_EXTENDED_SYNC 0x00000001
+#define E131_SYNC_PACKET_LEN 49
 
 #define P_E131   0
 #define P_ARTNET 1
@@ -123,7 +129,7 @@ typedef union {
       uint32_t frame_vector;
       uint8_t  source_name[64];
       uint8_t  priority;
-      uint16_t reserved;
+      uint16_t sync_address;    // universe of synchronization packets (0 = not synchronized)
       uint8_t  sequence_number;
       uint8_t  options;
       uint16_t universe;
@@ -475,6 +475,8 @@ void handleNotifications()
     notify(notificationSentCallMode,true);
   }
 
+  handleE131Frame();
+
   if (e131NewData && millis() - strip.getLastShow() > 15)
   {
     e131NewData = false;
@@ -505,12 +507,11 @@ void handleNotifications()
       DEBUG_PRINTLN(rgbUdp.remoteIP());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
+      unsigned long packetStart = micros();
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
       if (realtimeOverride) return;
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-      }
+      setRealtimePixels(0, lbuf, std::min(size_t(packetSize) / 3, size_t(strip.getLengthTotal())), 3);
+      countRealtimePacket(packetStart);
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
       return;
@@ -578,6 +579,7 @@ void handleNotifications()
       if (tpmType != 0xda) return; //return if notTPM2.NET data
 
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
+      unsigned long packetStart = micros();
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
       if (realtimeOverride) return;
 
@@ -590,9 +592,8 @@ void handleNotifications()
       unsigned totalLen = strip.getLengthTotal();
       // Clamp to prevent buffer overread: loop accesses up to udpIn[tpmPayloadFrameSize + 5]
       size_t currentPayloadFrameSize = (packetSize >= 5) ? min(tpmPayloadFrameSize, uint16_t(packetSize - 5)) : 0;
-      for (size_t i = 6; i < currentPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      if (id < totalLen) setRealtimePixels(id, &udpIn[6], std::min(currentPayloadFrameSize / 3, size_t(totalLen - id)), 3);
+      countRealtimePacket(packetStart);
       if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
         tpmPacketCount = 0;
         if (useMainSegmentOnly) strip.trigger();
@@ -606,6 +607,7 @@ void handleNotifications()
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
       DEBUG_PRINTLN(realtimeIP);
       if (packetSize < 2) return;
+      unsigned long packetStart = micros();
 
       if (udpIn[1] == 0) {
         realtimeTimeout = 0; // cancel realtime mode immediately
@@ -621,25 +623,17 @@ void handleNotifications()
           setRealtimePixel(udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3], 0);
         }
       } else if (udpIn[0] == 2 && packetSize > 4) { //drgb
-        for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-          {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-          }
+        setRealtimePixels(0, &udpIn[2], std::min((packetSize - 2) / 3, size_t(totalLen)), 3);
       } else if (udpIn[0] == 3 && packetSize > 6) { //drgbw
-          for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++) {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-          }
+        setRealtimePixels(0, &udpIn[2], std::min((packetSize - 2) / 4, size_t(totalLen)), 4);
       } else if (udpIn[0] == 4 && packetSize > 7) { //dnrgb
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        }
+        if (id < totalLen) setRealtimePixels(id, &udpIn[4], std::min((packetSize - 4) / 3, size_t(totalLen - id)), 3);
       } else if (udpIn[0] == 5 && packetSize > 8) { //dnrgbw
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        }
+        if (id < totalLen) setRealtimePixels(id, &udpIn[4], std::min((packetSize - 4) / 4, size_t(totalLen - id)), 4); // complete pixels only
       }
+      countRealtimePacket(packetStart);
       if (useMainSegmentOnly) strip.trigger();
       else                    strip.show();
       return;
@@ -672,6 +666,31 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// bulk version of setRealtimePixel() for consecutive pixels, channels: 3 (RGB) or 4 (RGBW) bytes per pixel
+void setRealtimePixels(unsigned start, const uint8_t *data, size_t count, unsigned channels)
+{
+  strip.setRealtimePixels(int(start) + arlsOffset, data, count, channels);
+}
+
+// updates packets/s and us/packet statistics, call once per received realtime packet
+// note: called from async UDP task for E1.31/Art-Net/DDP
+void countRealtimePacket(unsigned long startUs)
+{
+  static unsigned long windowStart = 0;
+  static uint32_t packets = 0;
+  static uint32_t packetTime = 0;
+  packets++;
+  packetTime += micros() - startUs;
+  unsigned long now = millis();
+  if (now - windowStart >= 1000) {
+    realtimePacketsPerSec = (packets * 1000) / (now - windowStart);
+    realtimeUsPerPacket   = packetTime / packets;
+    windowStart = now;
+    packets     = 0;
+    packetTime  = 0;
+  }
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -739,153 +758,163 @@ void sendSysInfoUDP()
 
 
 /*********************************************************************************************\
- * Art-Net, DDP, E131 output - work in progress
+ * Art-Net, DDP, E1.31 output (network busses)
 \*********************************************************************************************/
 
-//
-// Send real time UDP updates to the specified client
-//
-// type   - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
-// client - the IP address to send to
-// length - the number of pixels
-// buffer - a buffer of at least length*4 bytes long
-// isRGBW - true if the buffer contains 4 components per pixel
+// Every packet is assembled once in a shared buffer (protocol header followed by channel data with
+// brightness applied through a lookup table) and sent to all destinations of the bus through one
+// persistent UDP socket. Multi-universe frames (E1.31, Art-Net) are followed by a sync packet.
+
+#ifndef E131_OUTPUT_PRIORITY
+  #define E131_OUTPUT_PRIORITY 100  // sACN source priority (0-200)
+#endif
+#define E131_OUTPUT_UNIVERSE   1    // first universe sent, also used as synchronization universe
+#define NET_OUT_MAX_PACKET     (DDP_HEADER_LEN + DDP_CHANNELS_PER_PACKET) // DDP packets are largest (E1.31: 638, Art-Net: 530)
+
+static WiFiUDP  netOutUdp;                // kept across frames and destinations
+static uint8_t *netOutPacket = nullptr;   // allocated on first use
+static uint8_t  netOutLUT[256];           // brightness lookup table
+static int      netOutLUTBri = -1;        // brightness netOutLUT was built for
+static uint8_t  ddpSequence = 0, artnetSequence = 0, e131Sequence = 0;
 
-static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static const byte   ART_NET_SYNC[]   PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x52,0x00,0x0e,0x00,0x00};
+static const byte   E131_ACN_ID[]    PROGMEM = {0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // "ASC-E1.17"
+
+static inline void writeBE16(uint8_t *p, uint16_t v) { p[0] = v >> 8; p[1] = v; }
+static inline void writeBE32(uint8_t *p, uint32_t v) { writeBE16(p, v >> 16); writeBE16(p+2, v); }
+
+// copy channel data into packet applying brightness
+static void copyChannels(uint8_t *dst, const uint8_t *src, size_t len, uint8_t bri) {
+  if (bri == 255) { memcpy(dst, src, len); return; }
+  if (netOutLUTBri != bri) {
+    for (unsigned i = 0; i < 256; i++) netOutLUT[i] = scale8(i, bri);
+    netOutLUTBri = bri;
+  }
+  for (size_t i = 0; i < len; i++) dst[i] = netOutLUT[src[i]];
+}
+
+static bool sendNetPacket(const IPAddress *clients, size_t numClients, uint16_t port, size_t len) {
+  bool ok = true;
+  for (size_t c = 0; c < numClients; c++) {
+    if (!clients[c][0]) continue; // unset/unresolved destination
+    ok &= netOutUdp.beginPacket(clients[c], port) && netOutUdp.write(netOutPacket, len) == len && netOutUdp.endPacket();
+  }
+  return ok;
+}
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
-  if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
+// E1.31 root layer, shared by data and sync packets
+static void writeE131Root(uint8_t *p, size_t len, uint32_t vector) {
+  memset(p, 0, E131_FRAME_FLENGTH);
+  writeBE16(p + E131_ROOT_PREAMBLE_SIZE, 0x0010);
+  memcpy_P(p + E131_ROOT_ID, E131_ACN_ID, sizeof(E131_ACN_ID));
+  writeBE16(p + E131_ROOT_FLENGTH, 0x7000 | (len - E131_ROOT_FLENGTH));
+  writeBE32(p + E131_ROOT_VECTOR, vector);
+  memcpy_P(p + E131_ROOT_CID, PSTR("WLED"), 4); // CID must be unique and stable per source: use MAC
+  strncpy(reinterpret_cast<char*>(p + E131_ROOT_CID + 4), escapedMac.c_str(), 12);
+}
 
-  WiFiUDP ddpUdp;
+//
+// Send real time UDP updates to the specified clients
+//
+// type       - protocol type (0=DDP, 1=E1.31, 2=ArtNet)
+// clients    - the IP addresses to send to (the same data is sent to each)
+// length     - the number of pixels
+// buffer     - a buffer of at least length*4 bytes long
+// isRGBW     - true if the buffer contains 4 components per pixel
+uint8_t realtimeBroadcast(uint8_t type, const IPAddress *clients, size_t numClients, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
+  if (!(apActive || interfacesInited) || !numClients || !length) return 1;  // network not initialised or no destination
+  if (!netOutPacket) {
+    netOutPacket = static_cast<uint8_t*>(d_malloc(NET_OUT_MAX_PACKET));
+    if (!netOutPacket) return 1;
+  }
+  uint8_t *packet = netOutPacket;
+  const size_t channelCount = length * (isRGBW ? 4 : 3); // 1 channel for every R,G,B,(W) value
+  bool ok = true;
 
   switch (type) {
     case 0: // DDP
     {
-      // calculate the number of UDP packets we need to send
-      size_t channelCount = length * (isRGBW? 4:3); // 1 channel for every R,G,B value
-      size_t packetCount = ((channelCount-1) / DDP_CHANNELS_PER_PACKET) +1;
-
-      // there are 3 channels per RGB pixel
-      uint32_t channel = 0; // TODO: allow specifying the start channel
-      // the current position in the buffer
-      size_t bufferOffset = 0;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-        if (sequenceNumber > 15) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
-        // the amount of data is AFTER the header in the current packet
-        size_t packetSize = DDP_CHANNELS_PER_PACKET;
-
-        uint8_t flags = DDP_FLAGS_VER1;
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet, set the push flag
-          // TODO: determine if we want to send an empty push packet to each destination after sending the pixel data
-          flags = DDP_FLAGS_VER1 | DDP_FLAGS_PUSH;
-          if (channelCount % DDP_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % DDP_CHANNELS_PER_PACKET;
-          }
-        }
-
-        // write the header
-        /*0*/ddpUdp.write(flags);
-        // TODO: sequence number should be 1-15 as 0 means "unused", it has no bad consequences other than out of sequence packet may be accepted
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
-        // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
-        // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
-          return 1; // problem
-        }
-
+      packet[2] = isRGBW ? DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+      packet[3] = DDP_ID_DISPLAY;
+      for (size_t channel = 0; channel < channelCount && ok; ) { // TODO: allow specifying the start channel
+        const size_t packetSize = min(channelCount - channel, (size_t)DDP_CHANNELS_PER_PACKET);
+        const bool   last       = (channel + packetSize >= channelCount);
+        ddpSequence = (ddpSequence % 15) + 1; // 1-15, 0 means "unused"
+        packet[0] = DDP_FLAGS_VER1 | (last ? DDP_FLAGS_PUSH : 0); // push flag on last packet
+        packet[1] = ddpSequence;
+        writeBE32(packet + 4, channel); // data offset in bytes
+        writeBE16(packet + 8, packetSize);
+        copyChannels(packet + DDP_HEADER_LEN, buffer + channel, packetSize, bri);
+        ok = sendNetPacket(clients, numClients, DDP_DEFAULT_PORT, DDP_HEADER_LEN + packetSize);
         channel += packetSize;
       }
     } break;
 
-    case 1: //E1.31
+    case 1: // E1.31
     {
+      const size_t channelsPerUniverse = isRGBW ? 512 : 510; // 128 RGBW or 170 RGB LEDs
+      const size_t universeCount = (channelCount - 1) / channelsPerUniverse + 1;
+      e131Sequence++;
+      // framing and DMP layer fields that are the same for all universes
+      memset(packet, 0, E131_DMP_DATA + 1);
+      writeBE32(packet + E131_FRAME_VECTOR, 0x00000002); // VECTOR_E131_DATA_PACKET
+      strncpy(reinterpret_cast<char*>(packet + E131_FRAME_SOURCE), serverDescription, 63);
+      packet[E131_FRAME_PRIORITY] = E131_OUTPUT_PRIORITY;
+      writeBE16(packet + E131_FRAME_RESERVED, universeCount > 1 ? E131_OUTPUT_UNIVERSE : 0); // synchronization address
+      packet[E131_FRAME_SEQ] = e131Sequence;
+      packet[E131_DMP_VECTOR] = 0x02;                      // VECTOR_DMP_SET_PROPERTY
+      packet[E131_DMP_TYPE]   = 0xA1;
+      writeBE16(packet + E131_DMP_ADDR_INC, 1);
+      for (size_t u = 0; u < universeCount && ok; u++) {
+        const size_t channel    = u * channelsPerUniverse;
+        const size_t packetSize = min(channelCount - channel, channelsPerUniverse);
+        const size_t len        = E131_DMP_DATA + 1 + packetSize; // DMX start code precedes data
+        writeE131Root(packet, len, 0x00000004);            // VECTOR_ROOT_E131_DATA
+        writeBE16(packet + E131_FRAME_FLENGTH, 0x7000 | (len - E131_FRAME_FLENGTH));
+        writeBE16(packet + E131_FRAME_UNIVERSE, E131_OUTPUT_UNIVERSE + u);
+        writeBE16(packet + E131_DMP_FLENGTH, 0x7000 | (len - E131_DMP_FLENGTH));
+        writeBE16(packet + E131_DMP_COUNT, packetSize + 1);
+        copyChannels(packet + E131_DMP_DATA + 1, buffer + channel, packetSize, bri);
+        ok = sendNetPacket(clients, numClients, E131_DEFAULT_PORT, len);
+      }
+      if (ok && universeCount > 1) { // universe synchronization packet (latches all universes at once)
+        writeE131Root(packet, E131_SYNC_PACKET_LEN, E131_VECTOR_ROOT_EXTENDED);
+        writeBE16(packet + E131_FRAME_FLENGTH, 0x7000 | (E131_SYNC_PACKET_LEN - E131_FRAME_FLENGTH));
+        writeBE32(packet + E131_FRAME_VECTOR, E131_VECTOR_EXTENDED_SYNC);
+        packet[E131_FRAME_VECTOR + 4] = e131Sequence;
+        writeBE16(packet + E131_FRAME_VECTOR + 5, E131_OUTPUT_UNIVERSE);
+        writeBE16(packet + E131_FRAME_VECTOR + 7, 0);      // reserved
+        ok = sendNetPacket(clients, numClients, E131_DEFAULT_PORT, E131_SYNC_PACKET_LEN);
+      }
     } break;
 
-    case 2: //ArtNet
+    case 2: // ArtNet
     {
-      // calculate the number of UDP packets we need to send
-      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
-      const size_t ARTNET_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
-      const size_t packetCount = ((channelCount-1)/ARTNET_CHANNELS_PER_PACKET)+1;
-
-      uint32_t channel = 0; 
-      size_t bufferOffset = 0;
-
-      sequenceNumber++;
-
-      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
-
-        if (sequenceNumber > 255) sequenceNumber = 0;
-
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
-        size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
-
-        if (currentPacket == (packetCount - 1U)) {
-          // last packet
-          if (channelCount % ARTNET_CHANNELS_PER_PACKET) {
-            packetSize = channelCount % ARTNET_CHANNELS_PER_PACKET;
-          }
-        }
-
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
-
-        if (!ddpUdp.endPacket()) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
-          return 1; // borked
-        }
-        channel += packetSize;
+      const size_t channelsPerUniverse = isRGBW ? 512 : 510; // 128 RGBW or 170 RGB LEDs
+      const size_t universeCount = (channelCount - 1) / channelsPerUniverse + 1;
+      artnetSequence = (artnetSequence % 255) + 1; // 1-255, 0 disables sequence checking
+      memcpy_P(packet, ART_NET_HEADER, ART_NET_HEADER_SIZE); // hard coded ID, OpCode and protocol version
+      packet[12] = artnetSequence;
+      packet[13] = 0x00; // physical - more an FYI, not really used for anything
+      for (size_t u = 0; u < universeCount && ok; u++) {
+        const size_t channel    = u * channelsPerUniverse;
+        size_t       packetSize = min(channelCount - channel, channelsPerUniverse);
+        packet[14] = u & 0xFF;        // SubUni: 1 full packet == 1 full universe
+        packet[15] = (u >> 8) & 0x7F; // Net
+        copyChannels(packet + ART_NET_HEADER_SIZE + 6, buffer + channel, packetSize, bri);
+        if (packetSize & 1) packet[ART_NET_HEADER_SIZE + 6 + packetSize++] = 0; // length must be even
+        writeBE16(packet + 16, packetSize);
+        ok = sendNetPacket(clients, numClients, ARTNET_DEFAULT_PORT, ART_NET_HEADER_SIZE + 6 + packetSize);
+      }
+      if (ok && universeCount > 1) { // ArtSync (latches all universes at once)
+        memcpy_P(packet, ART_NET_SYNC, sizeof(ART_NET_SYNC));
+        ok = sendNetPacket(clients, numClients, ARTNET_DEFAULT_PORT, sizeof(ART_NET_SYNC));
       }
     } break;
   }
-  return 0;
+  return ok ? 0 : 1;
 }
 
 #ifndef WLED_DISABLE_ESPNOW
@@ -256,8 +256,89 @@ size_t utf8_strlen(const char *s)
   return len;
 }
 
+static JSONPoolStats jsonPoolStats;
+
+#if WLED_JSON_POOL_SIZE > 1
+// JSON document pool: besides pDoc, API requests, WebSocket and MQTT may use one of these documents (allocated on first use
+// and kept to avoid fragmentation) so that several clients do not have to wait for each other's responses to be sent
+static JsonDocument     *jsonPool[WLED_JSON_POOL_SIZE-1];
+static volatile uint8_t  jsonPoolOwner[WLED_JSON_POOL_SIZE-1];     // module ID holding the document, 0 = free
+static SemaphoreHandle_t jsonPoolMutex = nullptr; // guards claiming of pool documents (created in initJSONPool())
+
+static JsonDocument *allocateJSONDocument() {
+  #ifdef BOARD_HAS_PSRAM
+  if (psramFound() && ESP.getFreePsram() > 4 * JSON_BUFFER_SIZE) {
+    PSRAMDynamicJsonDocument *doc = new PSRAMDynamicJsonDocument(2 * JSON_BUFFER_SIZE);
+    if (doc && doc->capacity() == 0) { delete doc; doc = nullptr; }
+    return doc;
+  }
+  #endif
+  if (getContiguousFreeHeap() < JSON_BUFFER_SIZE + MIN_HEAP_SIZE) return nullptr; // do not starve the rest of the system
+  DynamicJsonDocument *doc = new DynamicJsonDocument(JSON_BUFFER_SIZE);
+  if (doc && doc->capacity() == 0) { delete doc; doc = nullptr; }
+  return doc;
+}
+
+static JsonDocument *claimPoolDocument(uint8_t moduleID) {
+  JsonDocument *doc = nullptr;
+  unsigned used = jsonBufferLock ? 1 : 0;
+  if (!jsonPoolMutex) return nullptr; // pool not initialised, only pDoc is available
+  xSemaphoreTake(jsonPoolMutex, portMAX_DELAY);
+  for (size_t i = 0; i < WLED_JSON_POOL_SIZE-1; i++) {
+    if (jsonPoolOwner[i]) { used++; continue; }
+    if (doc) continue;
+    if (!jsonPool[i]) {
+      jsonPool[i] = allocateJSONDocument();
+      DEBUG_PRINTF_P(PSTR("JSON pool document %u %s.\n"), i, jsonPool[i] ? "allocated" : "allocation failed");
+      if (!jsonPool[i]) continue;
+    }
+    jsonPoolOwner[i] = moduleID ? moduleID : 255;
+    doc = jsonPool[i];
+    used++;
+  }
+  xSemaphoreGive(jsonPoolMutex);
+  if (doc) {
+    if (used > jsonPoolStats.peak) jsonPoolStats.peak = used;
+    doc->clear();
+  }
+  return doc;
+}
+#endif
+
+// called from setup() once pDoc is allocated
+void initJSONPool()
+{
+#if WLED_JSON_POOL_SIZE > 1
+  if (!jsonPoolMutex) jsonPoolMutex = xSemaphoreCreateMutex();
+#endif
+}
+
+// wait accounting shared by pDoc and pool documents
+static void countJSONWait(unsigned long start, bool acquired) {
+  unsigned long waited = millis() - start;
+  if (waited) {
+    jsonPoolStats.waited++;
+    jsonPoolStats.waitMs += waited;
+    if (waited > jsonPoolStats.maxWaitMs) jsonPoolStats.maxWaitMs = waited;
+  }
+  if (acquired) jsonPoolStats.acquired++;
+  else          jsonPoolStats.failed++;
+}
+
+static JSONLockWait jsonLockWaits[JSON_LOCK_IDS];
+
+// wait accounting per owner of the global JSON lock
+static void countJSONLockWait(uint8_t moduleID, unsigned long start, bool acquired) {
+  JSONLockWait &w = jsonLockWaits[moduleID < JSON_LOCK_IDS ? moduleID : 0];
+  unsigned long waited = millis() - start;
+  w.waitMs += waited;
+  if (waited > w.maxWaitMs) w.maxWaitMs = min(waited, 65535UL);
+  if (acquired) w.locks++;
+  else          w.failed++;
+}
+
 //threading/network callback details: https://github.com/wled-dev/WLED/pull/2336#discussion_r762276994
-bool requestJSONBufferLock(uint8_t moduleID)
+static bool lockPrimaryDocument(uint8_t moduleID, unsigned timeout)
 {
   if (pDoc == nullptr) {
     DEBUG_PRINTLN(F("ERROR: JSON buffer not allocated!"));
@@ -268,20 +349,20 @@ bool requestJSONBufferLock(uint8_t moduleID)
   // Use a recursive mutex type in case our task is the one holding the JSON buffer.
   // This can happen during large JSON web transactions.  In this case, we continue immediately
   // and then will return out below if the lock is still held.
-  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) return false;  // timed out waiting
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, timeout) == pdFALSE) return false;  // timed out waiting
 #elif defined(ARDUINO_ARCH_ESP8266)
   // If we're in system context, delay() won't return control to the user context, so there's
   // no point in waiting.
   if (can_yield()) {
     unsigned long now = millis();
-    while (jsonBufferLock && (millis()-now < 250)) delay(1); // wait for fraction for buffer lock
+    while (jsonBufferLock && (millis()-now < timeout)) delay(1); // wait for fraction for buffer lock
   }
 #else
   #error Unsupported task framework - fix requestJSONBufferLock
 #endif  
   // If the lock is still held - by us, or by another task
   if (jsonBufferLock) {
-    DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
+    if (timeout) DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
 #endif
@@ -294,6 +375,15 @@ bool requestJSONBufferLock(uint8_t moduleID)
   return true;
 }
 
+bool requestJSONBufferLock(uint8_t moduleID)
+{
+  unsigned long start = millis();
+  bool locked = lockPrimaryDocument(moduleID, 250);
+  countJSONWait(start, locked);
+  countJSONLockWait(moduleID, start, locked);
+  return locked;
+}
+
 
 void releaseJSONBufferLock()
 {
@@ -304,6 +394,90 @@ void releaseJSONBufferLock()
 #endif  
 }
 
+// returns a cleared document from the pool, falling back to pDoc if all others are in use
+// the document is not tied to WLED state: use lockJSONState() while (de)serializing state or config
+JsonDocument *acquireJSONDocument(uint8_t moduleID)
+{
+#if WLED_JSON_POOL_SIZE > 1
+  unsigned long start = millis();
+  do {
+    JsonDocument *doc = claimPoolDocument(moduleID);
+    if (!doc && lockPrimaryDocument(moduleID, 0)) doc = pDoc;
+    if (doc) {
+      countJSONWait(start, true);
+      return doc;
+    }
+    delay(1);
+  } while (millis() - start < 250);
+  countJSONWait(start, false);
+  DEBUG_PRINTF_P(PSTR("ERROR: No JSON document for %d!\n"), moduleID);
+  return nullptr;
+#else
+  return requestJSONBufferLock(moduleID) ? pDoc : nullptr;
+#endif
+}
+
+void releaseJSONDocument(JsonDocument *doc)
+{
+  if (doc == nullptr) return;
+  if (doc == pDoc) {
+    releaseJSONBufferLock();
+    return;
+  }
+#if WLED_JSON_POOL_SIZE > 1
+  for (size_t i = 0; i < WLED_JSON_POOL_SIZE-1; i++) if (jsonPool[i] == doc) jsonPoolOwner[i] = 0;
+#endif
+}
+
+// WLED state used to be guarded by the single JSON buffer lock; pool documents are not, so readers and writers
+// of state in different tasks take the pDoc mutex for the short time they (de)serialize (recursive: pDoc holders pass)
+// limitation: this is still one global lock, read-only serialization (serveJson(), WS and MQTT state) waits for
+// deserializeState() and for any other pDoc holder (presets, config) as code applying state from pDoc does not
+// take a separate lock; getJSONLockWaits() (info "jpool"."lock") shows which owners are held up and for how long
+bool lockJSONState(uint8_t moduleID)
+{
+#if defined(ARDUINO_ARCH_ESP32) && WLED_JSON_POOL_SIZE > 1
+  unsigned long start = millis();
+  if (xSemaphoreTakeRecursive(jsonBufferLockMutex, 250) == pdFALSE) {
+    countJSONLockWait(moduleID, start, false);
+    DEBUG_PRINTF_P(PSTR("ERROR: Locking state (%d) failed! (locked by %d)\n"), moduleID, jsonBufferLock);
+    return false;
+  }
+  countJSONLockWait(moduleID, start, true);
+#endif
+  return true;
+}
+
+void unlockJSONState()
+{
+#if defined(ARDUINO_ARCH_ESP32) && WLED_JSON_POOL_SIZE > 1
+  xSemaphoreGiveRecursive(jsonBufferLockMutex);
+#endif
+}
+
+void countJSONDeferral()
+{
+  jsonPoolStats.deferred++;
+}
+
+const JSONLockWait *getJSONLockWaits()
+{
+  return jsonLockWaits;
+}
+
+JSONPoolStats getJSONPoolStats()
+{
+  JSONPoolStats stats = jsonPoolStats;
+  stats.owner[0] = jsonBufferLock;
+#if WLED_JSON_POOL_SIZE > 1
+  for (size_t i = 0; i < WLED_JSON_POOL_SIZE-1; i++) stats.owner[i+1] = jsonPoolOwner[i];
+#endif
+  stats.inUse = 0;
+  for (size_t i = 0; i < WLED_JSON_POOL_SIZE; i++) if (stats.owner[i]) stats.inUse++;
+  if (stats.inUse > stats.peak) stats.peak = stats.inUse;
+  return stats;
+}
+
 
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)! maxLen is (buffersize - 1)
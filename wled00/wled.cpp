@@ -49,117 +49,95 @@ void WLED::reset()
   ESP.restart();
 }
 
-void WLED::loop()
-{
-  static uint16_t      heapTime = 0;   // timestamp for heap check
-  static uint8_t       heapDanger = 0; // counter for consecutive low-heap readings
-#ifdef WLED_DEBUG
-  static unsigned long lastRun = 0;
-  unsigned long        loopMillis = millis();
-  size_t               loopDelay = loopMillis - lastRun;
-  if (lastRun == 0) loopDelay=0; // startup - don't have valid data from last run.
-  #if defined(ESP8266) || (SOC_CPU_CORES_NUM < 2)
-    if (loopDelay > 4) DEBUG_PRINTF_P(PSTR("Loop delayed more than %ums.\n"), loopDelay);  // be a bit more relaxed on single-core MCUs
-  #else
-    if (loopDelay > 2) DEBUG_PRINTF_P(PSTR("Loop delayed more than %ums.\n"), loopDelay);
+// block stuff if WARLS/Adalight is enabled
+static inline bool realtimeBlocksLoop() {
+  return realtimeMode && !realtimeOverride && !useMainSegmentOnly;
+}
+
+// ms until strip.service() renders the next frame, used by the loop scheduler to defer work that would make it late
+static unsigned msToNextFrame() {
+  if (realtimeBlocksLoop() || (offMode && !strip.isOffRefreshRequired() && !strip.needsUpdate())) return UINT_MAX; // no frame pending
+  return strip.msToNextFrame();
+}
+
+static void loopStrip() {
+  if (realtimeBlocksLoop()) return;
+  #ifdef WLED_ENABLE_ASYNC_SHOW
+  strip.flushShow(); // hand over deferred frame even if service() is not called (i.e. strip turned off)
   #endif
-  static unsigned long maxLoopMillis = 0;
-  static size_t        avgLoopMillis = 0;
-  static unsigned long maxUsermodMillis = 0;
-  static size_t        avgUsermodMillis = 0;
-  static unsigned long maxStripMillis = 0;
-  static size_t        avgStripMillis = 0;
-  unsigned long        stripMillis;
-#endif
+  if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
+    strip.service();
+  #ifdef ESP8266
+  else if (!noWifiSleep)
+    delay(1); //required to make sure ESP enters modem sleep (see #1184)
+  #endif
+}
 
-  handleTime();
+// loop subsystems in their order of execution: name, function, period (ms), budget (ms), priority
+static void registerLoopTasks() {
+  LoopScheduler::setFrameDeadline(msToNextFrame);
+  LoopScheduler::addTask(PSTR("time"),     handleTime,          0, 1, LoopPriority::High);
   #ifndef WLED_DISABLE_INFRARED
-  handleIR();        // 2nd call to function needed for ESP32 to return valid results -- should be good for ESP8266, too
+  LoopScheduler::addTask(PSTR("ir"),       handleIR,            0, 1, LoopPriority::Normal);
   #endif
-  handleConnection();
+  LoopScheduler::addTask(PSTR("conn"),     []() { WLED::instance().handleConnection(); }, 0, 1, LoopPriority::High);
   #ifdef WLED_ENABLE_ADALIGHT
-  handleSerial();
+  LoopScheduler::addTask(PSTR("serial"),   handleSerial,        0, 1, LoopPriority::High);
   #endif
-  handleImprovWifiScan();
-  handleNotifications();
-  handleTransitions();
+  LoopScheduler::addTask(PSTR("improv"),   handleImprovWifiScan, 0, 1, LoopPriority::Normal);
+  LoopScheduler::addTask(PSTR("notify"),   handleNotifications, 0, 1, LoopPriority::High);
+  LoopScheduler::addTask(PSTR("trans"),    handleTransitions,   0, 1, LoopPriority::High);
   #ifdef WLED_ENABLE_DMX
-  handleDMXOutput();
+  LoopScheduler::addTask(PSTR("dmx"),      handleDMXOutput,     0, 1, LoopPriority::High);
   #endif
   #ifdef WLED_ENABLE_DMX_INPUT
-  dmxInput.update();
-  #endif
-
-  #ifdef WLED_DEBUG
-  unsigned long usermodMillis = millis();
-  #endif
-  userLoop();
-  UsermodManager::loop();
-  #ifdef WLED_DEBUG
-  usermodMillis = millis() - usermodMillis;
-  avgUsermodMillis += usermodMillis;
-  if (usermodMillis > maxUsermodMillis) maxUsermodMillis = usermodMillis;
-  #endif
-
-  yield();
-  handleIO();
-  #ifndef WLED_DISABLE_INFRARED
-  handleIR();
+  LoopScheduler::addTask(PSTR("dmxin"),    []() { dmxInput.update(); }, 0, 1, LoopPriority::High);
   #endif
+  LoopScheduler::addTask(PSTR("usermods"), []() { userLoop(); UsermodManager::loop(); }, 0, 2, LoopPriority::Normal);
+  LoopScheduler::addTask(PSTR("io"),       handleIO,            0, 1, LoopPriority::Normal);
   #ifndef WLED_DISABLE_ESPNOW
-  handleRemote();
+  LoopScheduler::addTask(PSTR("remote"),   handleRemote,        0, 1, LoopPriority::Normal);
   #endif
   #ifndef WLED_DISABLE_ALEXA
-  handleAlexa();
+  LoopScheduler::addTask(PSTR("alexa"),    handleAlexa,         0, 1, LoopPriority::Normal);
   #endif
-
-  if (doCloseFile) {
-    closeFile();
-    yield();
-  }
-
-  #ifdef WLED_DEBUG
-  stripMillis = millis();
+  LoopScheduler::addTask(PSTR("file"),     []() { if (doCloseFile) closeFile(); }, 0, 2, LoopPriority::Low);
+  LoopScheduler::addTask(PSTR("dns"),      []() { if (apActive && !realtimeBlocksLoop()) dnsServer.processNextRequest(); }, 0, 1, LoopPriority::Normal);
+  #ifdef WLED_ENABLE_AOTA
+  LoopScheduler::addTask(PSTR("aota"),     []() { if (WLEDNetwork.isConnected() && aOtaEnabled && !otaLock && correctPIN && !realtimeBlocksLoop()) ArduinoOTA.handle(); }, 0, 1, LoopPriority::Normal);
   #endif
-  if (!realtimeMode || realtimeOverride || (realtimeMode && useMainSegmentOnly))  // block stuff if WARLS/Adalight is enabled
-  {
-    if (apActive) dnsServer.processNextRequest();
-    #ifdef WLED_ENABLE_AOTA
-    if (WLEDNetwork.isConnected() && aOtaEnabled && !otaLock && correctPIN) ArduinoOTA.handle();
-    #endif
-    handleNightlight();
-    yield();
-
-    #ifndef WLED_DISABLE_HUESYNC
-    handleHue();
-    yield();
-    #endif
-
-    if (!presetNeedsSaving()) {
-      handlePlaylist();
-      yield();
-    }
-    handlePresets();
-    yield();
-
-    if (!offMode || strip.isOffRefreshRequired() || strip.needsUpdate())
-      strip.service();
-    #ifdef ESP8266
-    else if (!noWifiSleep)
-      delay(1); //required to make sure ESP enters modem sleep (see #1184)
-    #endif
-  }
-  #ifdef WLED_DEBUG
-  stripMillis = millis() - stripMillis;
-  avgStripMillis += stripMillis;
-  if (stripMillis > maxStripMillis) maxStripMillis = stripMillis;
+  LoopScheduler::addTask(PSTR("nightlt"),  []() { if (!realtimeBlocksLoop()) handleNightlight(); }, 0, 1, LoopPriority::Normal);
+  #ifndef WLED_DISABLE_HUESYNC
+  LoopScheduler::addTask(PSTR("hue"),      []() { if (!realtimeBlocksLoop()) handleHue(); }, 0, 2, LoopPriority::Low);
   #endif
+  LoopScheduler::addTask(PSTR("playlist"), []() { if (!realtimeBlocksLoop() && !presetNeedsSaving()) handlePlaylist(); }, 0, 1, LoopPriority::Normal);
+  LoopScheduler::addTask(PSTR("presets"),  []() { if (!realtimeBlocksLoop()) handlePresets(); }, 0, 10, LoopPriority::Normal); // applying a preset reads from FS
+  LoopScheduler::addTask(PSTR("strip"),    loopStrip,           0, 0, LoopPriority::Frame);
+  #ifdef ESP8266
+  LoopScheduler::addTask(PSTR("mdns"),     []() { MDNS.update(); }, 0, 1, LoopPriority::Normal);
+  #endif
+}
 
-  yield();
-#ifdef ESP8266
-  MDNS.update();
+void WLED::loop()
+{
+  static uint16_t      heapTime = 0;   // timestamp for heap check
+  static uint8_t       heapDanger = 0; // counter for consecutive low-heap readings
+#ifdef WLED_DEBUG
+  static unsigned long lastRun = 0;
+  unsigned long        loopMillis = millis();
+  size_t               loopDelay = loopMillis - lastRun;
+  if (lastRun == 0) loopDelay=0; // startup - don't have valid data from last run.
+  #if defined(ESP8266) || (SOC_CPU_CORES_NUM < 2)
+    if (loopDelay > 4) DEBUG_PRINTF_P(PSTR("Loop delayed more than %ums.\n"), loopDelay);  // be a bit more relaxed on single-core MCUs
+  #else
+    if (loopDelay > 2) DEBUG_PRINTF_P(PSTR("Loop delayed more than %ums.\n"), loopDelay);
+  #endif
+  static unsigned long maxLoopMillis = 0;
+  static size_t        avgLoopMillis = 0;
 #endif
 
+  LoopScheduler::run(); // time, connection, notifications, usermods, presets, strip.service() etc., see registerLoopTasks()
+
   //millis() rolls over every 50 days
   if (lastMqttReconnectAttempt > millis()) {
     rolloverMillis++;
@@ -243,6 +221,16 @@ void WLED::loop()
     strip.deserializeMap(loadLedmap);
     loadLedmap = -1;
   }
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  if (fxBenchWidth) {
+    File f = WLED_FS.open(F("/fxbench.csv"), "w");
+    if (f) {
+      strip.benchmarkEffects(f, fxBenchWidth, fxBenchHeight, fxBenchFrames, fxBenchMode);
+      f.close();
+    }
+    fxBenchWidth = 0;
+  }
+  #endif
   yield();
   if (configNeedsWrite) serializeConfigToFS();
 
@@ -275,8 +263,6 @@ void WLED::loop()
   loopMillis = millis() - loopMillis;
   //if (loopMillis > 30) {
   //  DEBUG_PRINTF_P(PSTR("Loop took %lums.\n"), loopMillis);
-  //  DEBUG_PRINTF_P(PSTR("Usermods took %lums.\n"), usermodMillis);
-  //  DEBUG_PRINTF_P(PSTR("Strip took %lums.\n"), stripMillis);
   //}
   avgLoopMillis += loopMillis;
   if (loopMillis > maxLoopMillis) maxLoopMillis = loopMillis;
@@ -332,18 +318,13 @@ void WLED::loop()
     if (loops > 0) { // avoid division by zero
       DEBUG_PRINTF_P(PSTR("Loops/sec: %u\n"),         loops / 30);
       DEBUG_PRINTF_P(PSTR("Loop time[ms]: %u/%lu\n"), avgLoopMillis/loops,    maxLoopMillis);
-      DEBUG_PRINTF_P(PSTR("UM time[ms]: %u/%lu\n"),   avgUsermodMillis/loops, maxUsermodMillis);
-      DEBUG_PRINTF_P(PSTR("Strip time[ms]:%u/%lu\n"), avgStripMillis/loops,   maxStripMillis);
     }
+    LoopScheduler::printStats(DEBUGOUT);
     strip.printSize();
     server.printStatus(DEBUGOUT);
     loops = 0;
     maxLoopMillis = 0;
-    maxUsermodMillis = 0;
-    maxStripMillis = 0;
     avgLoopMillis = 0;
-    avgUsermodMillis = 0;
-    avgStripMillis = 0;
     debugTime = millis();
   }
   loops++;
@@ -449,6 +430,7 @@ void WLED::setup()
     pDoc = new DynamicJsonDocument(JSON_BUFFER_SIZE);  // Use onboard RAM instead as a fallback
   }
 #endif
+  initJSONPool(); // additional JSON documents for API requests (allocated on first use)
 
 #if defined(ARDUINO_ARCH_ESP32)
   DEBUG_PRINTF_P(PSTR("TX power: %d/%d\n"), WiFi.getTxPower(), txPower);
@@ -643,6 +625,7 @@ void WLED::setup()
   #if defined(ARDUINO_ARCH_ESP32) && defined(WLED_DISABLE_BROWNOUT_DET)
   WRITE_PERI_REG(RTC_CNTL_BROWN_OUT_REG, 1); //enable brownout detector
   #endif
+  registerLoopTasks();
   markOTAvalid();
 }
 
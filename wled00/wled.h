@@ -213,6 +213,7 @@ using PSRAMDynamicJsonDocument = BasicJsonDocument<PSRAM_Allocator>;
 #include "pin_manager.h"
 #include "bus_manager.h"
 #include "FX.h"
+#include "loop_scheduler.h"
 #include "wled_metadata.h"
 
 #ifndef CLIENT_SSID
@@ -509,6 +510,9 @@ WLED_GLOBAL uint16_t DMXSegmentSpacing _INIT(0);                  // Number of v
 WLED_GLOBAL byte e131LastSequenceNumber[E131_MAX_UNIVERSE_COUNT]; // to detect packet loss
 WLED_GLOBAL bool e131Multicast _INIT(false);                      // multicast or unicast
 WLED_GLOBAL bool e131SkipOutOfSequence _INIT(false);              // freeze instead of flickering
+WLED_GLOBAL uint8_t e131FrameTimeout _INIT(20);                   // ms to wait for remaining universes of a frame (0 = show each universe)
+WLED_GLOBAL uint16_t e131LatePerSec _INIT(0);                     // out-of-sequence E1.31/Art-Net packets in last second
+WLED_GLOBAL uint16_t e131DroppedPerSec _INIT(0);                  // universes missing from shown frames in last second
 WLED_GLOBAL uint16_t pollReplyCount _INIT(0);                     // count number of replies for ArtPoll node report
 
 // mqtt
@@ -860,6 +864,8 @@ WLED_GLOBAL unsigned long realtimeTimeout _INIT(0);
 WLED_GLOBAL uint8_t tpmPacketCount _INIT(0);
 WLED_GLOBAL uint16_t tpmPayloadFrameSize _INIT(0);
 WLED_GLOBAL bool useMainSegmentOnly _INIT(false);
+WLED_GLOBAL uint16_t realtimePacketsPerSec _INIT(0);   // received realtime packets (E1.31, Art-Net, DDP, UDP) in last second
+WLED_GLOBAL uint16_t realtimeUsPerPacket _INIT(0);     // average time spent processing a realtime packet (us)
 WLED_GLOBAL bool realtimeRespectLedMaps _INIT(true);                     // Respect LED maps when receiving realtime data
 
 WLED_GLOBAL unsigned long lastInterfaceUpdate _INIT(0);
@@ -943,6 +949,12 @@ WLED_GLOBAL std::vector<BusConfig> busConfigs;    //temporary, to remember value
 WLED_GLOBAL bool       doInitBusses  _INIT(false);
 WLED_GLOBAL int8_t     loadLedmap    _INIT(-1);
 WLED_GLOBAL uint8_t    currentLedmap _INIT(0);
+#ifdef WLED_ENABLE_FX_BENCHMARK
+WLED_GLOBAL uint16_t   fxBenchWidth  _INIT(0);     // pending effect benchmark request (0 = none)
+WLED_GLOBAL uint16_t   fxBenchHeight _INIT(1);
+WLED_GLOBAL uint16_t   fxBenchFrames _INIT(0);
+WLED_GLOBAL uint8_t    fxBenchMode   _INIT(255);   // 255 = all effects
+#endif
 #ifndef ESP8266
 WLED_GLOBAL char  *ledmapNames[WLED_MAX_LEDMAPS-1] _INIT_N(({nullptr}));
 #endif
@@ -207,6 +207,9 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
     if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.indexOf(F("/ledmap")) == 0 && finalname.indexOf(F(".json")) > 0) {
+      WLED_FS.remove(finalname.substring(0, finalname.lastIndexOf('.')) + F(".lmb")); // compiled ledmap is stale, recreated on next load
+    }
   }
   if (len) {
     request->_tempFile.write(data,len);
@@ -411,18 +414,26 @@ void initServer()
     bool verboseResponse = false;
     bool isConfig = false;
 
-    if (!requestJSONBufferLock(JSON_LOCK_SERVER)) {
+    JsonDocument *doc = acquireJSONDocument(JSON_LOCK_SERVER);
+    if (!doc) {
+      countJSONDeferral();
       request->deferResponse();
       return;
     }
 
-    DeserializationError error = deserializeJson(*pDoc, (uint8_t*)(request->_tempObject));
-    JsonObject root = pDoc->as<JsonObject>();
+    DeserializationError error = deserializeJson(*doc, (uint8_t*)(request->_tempObject));
+    JsonObject root = doc->as<JsonObject>();
     if (error || root.isNull()) {
-      releaseJSONBufferLock();
+      releaseJSONDocument(doc);
       serveJsonError(request, 400, ERR_JSON);
       return;
     }
+    if (!lockJSONState(JSON_LOCK_SERVER)) {
+      releaseJSONDocument(doc);
+      countJSONDeferral();
+      request->deferResponse();
+      return;
+    }
     if (root.containsKey("pin")) checkSettingsPIN(root["pin"].as<const char*>());
 
     const String& url = request->url();
@@ -438,13 +449,15 @@ void initServer()
       verboseResponse = deserializeState(root);
     } else {
       if (!correctPIN && strlen(settingsPIN)>0) {
-        releaseJSONBufferLock();
+        unlockJSONState();
+        releaseJSONDocument(doc);
         serveJsonError(request, 401, ERR_DENIED);
         return;
       }
       verboseResponse = deserializeConfig(root); //use verboseResponse to determine whether cfg change should be saved immediately
     }
-    releaseJSONBufferLock();
+    unlockJSONState();
+    releaseJSONDocument(doc);
 
     if (verboseResponse) {
       if (!isConfig) {
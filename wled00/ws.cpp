@@ -14,11 +14,120 @@ constexpr uint8_t BINARY_PROTOCOL_E131    = P_E131; // = 0, untested!
 constexpr uint8_t BINARY_PROTOCOL_ARTNET  = P_ARTNET; // = 1, untested!
 constexpr uint8_t BINARY_PROTOCOL_DDP     = P_DDP; // = 2
 
-static uint16_t wsLiveClientId = 0;
 static unsigned long wsLastLiveTime = 0;
 //static uint8_t* wsFrameBuffer = nullptr;
 
-#define WS_LIVE_INTERVAL 40
+#define WS_LIVE_INTERVAL     40 // ms, default live view frame interval (and client cleanup interval)
+#define WS_LIVE_MIN_INTERVAL 20 // ms, max. 50 fps
+#define WS_LIVE_KEYFRAME    100 // send full frame every n frames in delta mode (recover from lost messages)
+#ifdef ESP8266
+#define WS_LIVE_MAX_CLIENTS 2
+#else
+#define WS_LIVE_MAX_CLIENTS 4
+#endif
+
+/*
+ * Live view clients
+ * {"lv":true} selects the legacy downsampled stream (version 1/2, see sendLiveLedsWs()),
+ * {"lv":{"fps":25,"enc":1}} selects the full resolution stream (version 3, see sendLiveFrameWs()).
+ * {"lv":false} stops the stream for this client.
+ */
+struct LiveClient {
+  uint32_t id;              // WS client ID, 0 = unused slot
+  uint16_t interval;        // ms between frames
+  uint8_t  version;         // 1: legacy (1D/2D chosen by ws.cpp), 3: full resolution
+  bool     delta;           // version 3: delta/RLE encode against last frame sent
+  uint8_t  sinceKey;        // frames since last keyframe
+  unsigned long lastSent;
+  uint8_t *prev;            // version 3 delta: last frame sent to this client (RGB)
+  size_t   prevLen;
+};
+static LiveClient wsLiveClients[WS_LIVE_MAX_CLIENTS] = {};
+static uint8_t *wsLiveFrame = nullptr; // current frame (RGB) shared by all version 3 clients
+static size_t   wsLiveFrameLen = 0;
+
+static LiveClient *findLiveClient(uint32_t id) {
+  for (auto &lc : wsLiveClients) if (lc.id == id) return &lc;
+  return nullptr;
+}
+
+/*
+ * Slot changes requested by WS events (AsyncTCP task) are queued and applied by handleWs() (loop task),
+ * which owns the slot table and all live view buffers (single producer, single consumer ring).
+ */
+struct LiveRequest {
+  uint32_t id;
+  uint16_t interval;
+  uint8_t  version;         // 0: remove client
+  bool     delta;
+};
+#define WS_LIVE_REQUESTS 8
+static LiveRequest      wsLiveRequests[WS_LIVE_REQUESTS];
+static volatile uint8_t wsLiveReqHead = 0; // written by WS events only
+static volatile uint8_t wsLiveReqTail = 0; // written by handleWs() only
+
+static void queueLiveRequest(const LiveRequest &req) {
+  uint8_t head = wsLiveReqHead;
+  uint8_t next = (head + 1) % WS_LIVE_REQUESTS;
+  if (next == wsLiveReqTail) { DEBUG_PRINTLN(F("WS live request queue full.")); return; }
+  wsLiveRequests[head] = req;
+  __sync_synchronize(); // request must be complete before it is published
+  wsLiveReqHead = next;
+}
+
+static void removeLiveClient(uint32_t id) {
+  LiveRequest req = {};
+  req.id = id;
+  queueLiveRequest(req);
+}
+
+static void setLiveClient(uint32_t id, JsonVariant lv) {
+  if (!lv.is<JsonObject>() && !lv.as<bool>()) {
+    removeLiveClient(id);
+    return;
+  }
+  LiveRequest req = {};
+  req.id       = id;
+  req.interval = WS_LIVE_INTERVAL;
+  req.version  = 1;
+  if (lv.is<JsonObject>()) {
+    unsigned fps = lv[F("fps")] | (1000 / WS_LIVE_INTERVAL);
+    req.interval = 1000 / constrain(fps, 1U, 1000U / WS_LIVE_MIN_INTERVAL);
+    req.delta    = lv[F("enc")] | 1;
+    req.version  = 3;
+  }
+  queueLiveRequest(req);
+}
+
+// applies queued slot changes, loop task only
+static void applyLiveRequests() {
+  while (wsLiveReqTail != wsLiveReqHead) {
+    __sync_synchronize();
+    const LiveRequest req = wsLiveRequests[wsLiveReqTail];
+    wsLiveReqTail = (wsLiveReqTail + 1) % WS_LIVE_REQUESTS;
+    LiveClient *lc = findLiveClient(req.id);
+    if (req.version == 0) {
+      if (!lc) continue;
+      p_free(lc->prev);
+      *lc = {};
+      continue;
+    }
+    if (!lc) lc = findLiveClient(0); // free slot
+    if (!lc) continue;               // too many viewers
+    p_free(lc->prev);                // (re)negotiation always starts with a keyframe
+    *lc = {};
+    lc->id       = req.id;
+    lc->interval = req.interval;
+    lc->version  = req.version;
+    lc->delta    = req.delta;
+  }
+  // release shared frame buffer if no full resolution client is left
+  if (!wsLiveFrame) return;
+  for (const auto &c : wsLiveClients) if (c.id && c.version == 3) return;
+  p_free(wsLiveFrame);
+  wsLiveFrame = nullptr;
+  wsLiveFrameLen = 0;
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
@@ -28,7 +137,7 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
-    if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    removeLiveClient(client->id());
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -45,26 +154,34 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
         }
 
         bool verboseResponse = false;
-        if (!requestJSONBufferLock(JSON_LOCK_WS_RECEIVE)) {
+        JsonDocument *doc = acquireJSONDocument(JSON_LOCK_WS_RECEIVE);
+        if (!doc) {
+          countJSONDeferral();
           client->text(F("{\"error\":3}")); // ERR_NOBUF
           return;
         }
 
-        DeserializationError error = deserializeJson(*pDoc, data, len);
-        JsonObject root = pDoc->as<JsonObject>();
+        DeserializationError error = deserializeJson(*doc, data, len);
+        JsonObject root = doc->as<JsonObject>();
         if (error || root.isNull()) {
-          releaseJSONBufferLock();
+          releaseJSONDocument(doc);
           return;
         }
         if (root["v"] && root.size() == 1) {
           //if the received value is just "{"v":true}", send only to this client
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
-        } else {
+          setLiveClient(client->id(), root["lv"]);
+        } else if (lockJSONState(JSON_LOCK_WS_RECEIVE)) {
           verboseResponse = deserializeState(root);
+          unlockJSONState();
+        } else {
+          releaseJSONDocument(doc);
+          countJSONDeferral();
+          client->text(F("{\"error\":3}")); // ERR_NOBUF
+          return;
         }
-        releaseJSONBufferLock();
+        releaseJSONDocument(doc);
 
         if (!interfaceUpdateCallMode) { // individual client response only needed if no WS broadcast soon
           if (verboseResponse) {
@@ -134,7 +251,10 @@ void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
-  if (!requestJSONBufferLock(JSON_LOCK_WS_SEND)) {
+  JsonDocument *doc = acquireJSONDocument(JSON_LOCK_WS_SEND);
+  if (!doc || !lockJSONState(JSON_LOCK_WS_SEND)) {
+    releaseJSONDocument(doc);
+    countJSONDeferral();
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -144,13 +264,13 @@ void sendDataWs(AsyncWebSocketClient * client)
     return;
   }
 
-  JsonObject state = pDoc->createNestedObject("state");
+  JsonObject state = doc->createNestedObject("state");
   serializeState(state);
-  JsonObject info  = pDoc->createNestedObject("info");
+  JsonObject info  = doc->createNestedObject("info");
   serializeInfo(info);
 
-  size_t len = measureJson(*pDoc);
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), pDoc->memoryUsage(), len);
+  size_t len = measureJson(*doc);
+  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), doc->memoryUsage(), len);
 
   // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
   size_t heap1 = getFreeHeapSize();
@@ -163,13 +283,15 @@ void sendDataWs(AsyncWebSocketClient * client)
   size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
   #endif
   if (!buffer || heap1-heap2<len) {
-    releaseJSONBufferLock();
+    unlockJSONState();
+    releaseJSONDocument(doc);
     DEBUG_PRINTLN(F("WS buffer allocation failed."));
     ws.closeAll(1013); //code 1013 = temporary overload, try again later
     ws.cleanupClients(0); //disconnect all clients to release memory
     return; //out of memory
   }
-  serializeJson(*pDoc, (char *)buffer.data(), len);
+  serializeJson(*doc, (char *)buffer.data(), len);
+  unlockJSONState(); // document no longer refers to state, others may change it while data is sent
 
   DEBUG_PRINT(F("Sending WS data "));
   if (client) {
@@ -180,7 +302,7 @@ void sendDataWs(AsyncWebSocketClient * client)
     ws.textAll(std::move(buffer));
   }
 
-  releaseJSONBufferLock();
+  releaseJSONDocument(doc);
 }
 
 static bool sendLiveLedsWs(uint32_t wsClient)
@@ -242,6 +364,115 @@ static bool sendLiveLedsWs(uint32_t wsClient)
   return true;
 }
 
+/*
+ * Delta/RLE encoder for live view version 3
+ * Token stream (pixel count in lower bits is n+1):
+ *   00nnnnnn             skip: pixels unchanged since previous frame (only if prev != nullptr)
+ *   01nnnnnn R G B       repeat: pixels set to one color
+ *   1nnnnnnn R G B ...   literal: n+1 RGB triplets follow
+ * Returns encoded size, only measures if out == nullptr.
+ */
+static size_t encodeLiveFrame(const uint8_t *cur, const uint8_t *prev, size_t pixels, uint8_t *out) {
+  auto same    = [](const uint8_t *a, const uint8_t *b) { return a[0] == b[0] && a[1] == b[1] && a[2] == b[2]; };
+  auto isSkip  = [&](size_t i) { return prev && same(cur + 3*i, prev + 3*i); };
+  auto isRun   = [&](size_t i) { return i + 1 < pixels && same(cur + 3*i, cur + 3*(i+1)); };
+  size_t len = 0;
+  size_t i = 0;
+  while (i < pixels) {
+    size_t n = 1;
+    if (isSkip(i)) {
+      while (i + n < pixels && n < 64 && isSkip(i + n)) n++;
+      if (out) out[len] = n - 1;
+      len++;
+    } else if (isRun(i)) {
+      while (i + n < pixels && n < 64 && same(cur + 3*i, cur + 3*(i+n))) n++;
+      if (out) { out[len] = 0x40 | (n - 1); memcpy(out + len + 1, cur + 3*i, 3); }
+      len += 4;
+    } else {
+      while (i + n < pixels && n < 128 && !isSkip(i + n) && !isRun(i + n)) n++;
+      if (out) { out[len] = 0x80 | (n - 1); memcpy(out + len + 1, cur + 3*i, 3*n); }
+      len += 1 + 3*n;
+    }
+    i += n;
+  }
+  return len;
+}
+
+/*
+ * Full resolution live view (version 3)
+ * Header: 'L', 3, encoding (0: raw RGB, 1: token stream, see encodeLiveFrame()), flags (bit 0: 2D), width (LE16), height (LE16)
+ */
+static bool sendLiveFrameWs(LiveClient &lc, const uint8_t *frame, size_t pixels, unsigned width, unsigned height)
+{
+  AsyncWebSocketClient * wsc = ws.client(lc.id);
+  if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
+
+  const size_t frameLen = pixels * 3;
+  const uint8_t *prev = nullptr;
+  if (lc.delta && lc.prev && lc.prevLen == frameLen && lc.sinceKey < WS_LIVE_KEYFRAME) prev = lc.prev;
+
+  constexpr size_t HEADER_LEN = 8;
+  size_t encLen = lc.delta ? encodeLiveFrame(frame, prev, pixels, nullptr) : SIZE_MAX;
+  bool encoded = encLen < frameLen;
+  AsyncWebSocketBuffer wsBuf(HEADER_LEN + (encoded ? encLen : frameLen));
+  if (!wsBuf) return false; //out of memory
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(wsBuf.data());
+  if (!buffer) return false; //out of memory
+  buffer[0] = 'L';
+  buffer[1] = 3; //version
+  buffer[2] = encoded;
+  buffer[3] = height > 1;
+  buffer[4] = width & 0xFF;
+  buffer[5] = width >> 8;
+  buffer[6] = height & 0xFF;
+  buffer[7] = height >> 8;
+  if (encoded) encodeLiveFrame(frame, prev, pixels, buffer + HEADER_LEN);
+  else         memcpy(buffer + HEADER_LEN, frame, frameLen);
+  wsc->binary(std::move(wsBuf));
+
+  // remember what the client has for next delta
+  if (lc.delta) {
+    if (lc.prevLen != frameLen) {
+      p_free(lc.prev);
+      lc.prev = static_cast<uint8_t*>(p_malloc(frameLen));
+      lc.prevLen = lc.prev ? frameLen : 0;
+    }
+    if (lc.prev) memcpy(lc.prev, frame, frameLen);
+    lc.sinceKey = prev ? lc.sinceKey + 1 : 0;
+  }
+  return true;
+}
+
+// capture current output (RGB, white added to RGB) for version 3 clients, returns pixel count or 0 on failure
+static size_t captureLiveFrame(unsigned &width, unsigned &height)
+{
+  width  = strip.getLengthTotal();
+  height = 1;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    // ignore anything behind matrix (i.e. extra strip)
+    width  = Segment::maxWidth;
+    height = Segment::maxHeight;
+  }
+#endif
+  const size_t pixels = width * height;
+  if (wsLiveFrameLen != pixels * 3) {
+    p_free(wsLiveFrame);
+    wsLiveFrame = static_cast<uint8_t*>(p_malloc(pixels * 3));
+    wsLiveFrameLen = wsLiveFrame ? pixels * 3 : 0;
+    if (!wsLiveFrame) return 0;
+  }
+  uint8_t *p = wsLiveFrame;
+  for (size_t i = 0; i < pixels; i++) {
+    uint32_t c = strip.getPixelColor(i); // note: LEDs mapped outside of valid range are set to black
+    uint8_t w = W(c);
+    *p++ = bri ? qadd8(w, R(c)) : 0; //R, add white channel to RGB channels as a simple RGBW -> RGB map
+    *p++ = bri ? qadd8(w, G(c)) : 0; //G
+    *p++ = bri ? qadd8(w, B(c)) : 0; //B
+  }
+  return pixels;
+}
+
 void handleWs()
 {
   if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
@@ -251,10 +482,24 @@ void handleWs()
     #else
     ws.cleanupClients();
     #endif
-    bool success = true;
-    if (wsLiveClientId) success = sendLiveLedsWs(wsLiveClientId);
     wsLastLiveTime = millis();
-    if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
+  }
+  applyLiveRequests();
+
+  unsigned width = 0, height = 0;
+  size_t pixels = 0;
+  bool captured = false; // capture at most once per call, shared by all full resolution clients
+  for (auto &lc : wsLiveClients) {
+    if (!lc.id || millis() - lc.lastSent < lc.interval) continue;
+    bool success;
+    if (lc.version == 3) {
+      if (!captured) { pixels = captureLiveFrame(width, height); captured = true; }
+      success = pixels && sendLiveFrameWs(lc, wsLiveFrame, pixels, width, height);
+    } else {
+      success = sendLiveLedsWs(lc.id);
+    }
+    lc.lastSent = millis();
+    if (!success) lc.lastSent -= lc.interval / 2; //try again sooner if failed due to non-empty WS queue
   }
 }
 